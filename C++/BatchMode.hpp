@@ -0,0 +1,345 @@
+#ifndef BATCH_MODE_HPP
+#define BATCH_MODE_HPP
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "LinkedListNodes.hpp"
+#include "MatchingAlgorithm.hpp"
+#include "StreamingMatch.hpp"
+#include "Metrics.hpp"
+#include "SkillTaxonomy.hpp"
+using namespace std;
+
+// Non-interactive entry point: main() hands over to runBatch() whenever it
+// gets command-line arguments, so pipelines can run a match without the menu.
+//
+//   ./main --algorithm weighted --threads 0 --format json --output matches.json
+//   ./main --resumes huge.csv --stream 50000 --output matches.csv --job-stats jobs.csv
+//
+// Results go through one large buffer and are never flushed per line.
+// Progress messages from the loaders go to stderr.
+
+// Output stream over a FILE* with a large buffer of its own; "-" is stdout
+class BufferedFileWriter : public streambuf {
+private:
+    FILE* file;
+    bool ownsFile;
+    vector<char> buffer;
+    bool failed;
+
+    bool drain() {
+        size_t pending = pptr() - pbase();
+        if (pending > 0 && fwrite(pbase(), 1, pending, file) != pending) failed = true;
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return !failed;
+    }
+
+protected:
+    int overflow(int c) override {
+        if (file == nullptr || !drain()) return traits_type::eof();
+        if (c != traits_type::eof()) {
+            *pptr() = (char)c;
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        if (file == nullptr || !drain()) return -1;
+        return fflush(file) == 0 ? 0 : -1;
+    }
+
+public:
+    explicit BufferedFileWriter(size_t bufferBytes = 1 << 20)
+        : file(nullptr), ownsFile(false), buffer(bufferBytes), failed(false) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    ~BufferedFileWriter() { close(); }
+
+    bool open(const string& path) {
+        close();
+        if (path == "-") {
+            file = stdout;
+            ownsFile = false;
+        } else {
+            file = fopen(path.c_str(), "wb");
+            ownsFile = true;
+        }
+        failed = (file == nullptr);
+        return !failed;
+    }
+
+    // Writes out what is buffered; false if any write failed
+    bool close() {
+        if (file == nullptr) return !failed;
+        if (sync() != 0) failed = true;
+        if (ownsFile && fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+};
+
+struct BatchOptions {
+    string jobCsv = "job_description.csv";
+    string resumeCsv = "resume.csv";
+    string algorithm = "keyword";
+    string format = "csv";
+    string output = "-";
+    string jobStatsOutput;     // CSV only; JSON puts the job stats in the same document
+    string metricsOutput;
+    string taxonomy;           // skill taxonomy file; empty keeps the built-in one
+    string matchMode;          // overrides the taxonomy's match mode when set
+    int threads = 1;
+    int topK = 1;
+    int streamBatch = 0;       // > 0 streams the resume file in batches of this size
+};
+
+inline void printBatchUsage() {
+    cerr << "Usage: main [options]   (no options starts the interactive menu)\n"
+            "  --jobs FILE            job CSV (default job_description.csv)\n"
+            "  --resumes FILE         resume CSV (default resume.csv)\n"
+            "  --algorithm NAME       keyword or weighted (default keyword)\n"
+            "  --threads N            matching threads, 0 = all cores (default 1)\n"
+            "  --top-k N              recommendations per resume (default 1)\n"
+            "  --format csv|json      output format (default csv)\n"
+            "  --output FILE          resume matches, - for stdout (default -)\n"
+            "  --job-stats FILE       job stats as CSV (csv format only)\n"
+            "  --stream N             read resumes in batches of N instead of all at once (csv only)\n"
+            "  --metrics FILE         record run metrics and export them (.csv or JSON)\n"
+            "  --taxonomy FILE        skills, tiers, weights and aliases to match with\n"
+            "  --match MODE           words (default) or substrings, to find skills in descriptions\n";
+}
+
+// Whole-string integer of at least `minimum` for option `arg`; reports and
+// returns false on anything else, so "--threads abc" is not read as 0. The
+// benchmark's options are parsed with it too.
+inline bool parseNumberOption(const string& arg, const string& value, int minimum, int& number) {
+    const char* text = value.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < minimum || parsed > INT_MAX) {
+        cerr << "Error: " << arg << " needs a whole number of at least " << minimum << ", not '" << value << "'\n";
+        return false;
+    }
+    number = (int)parsed;
+    return true;
+}
+
+inline bool parseBatchArguments(int argc, char** argv, BatchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+        if (i + 1 >= argc) {
+            cerr << "Error: " << arg << " needs a value\n";
+            return false;
+        }
+        string value = argv[++i];
+        if (arg == "--jobs") options.jobCsv = value;
+        else if (arg == "--resumes") options.resumeCsv = value;
+        else if (arg == "--algorithm") options.algorithm = value;
+        else if (arg == "--threads") { if (!parseNumberOption(arg, value, 0, options.threads)) return false; }
+        else if (arg == "--top-k") { if (!parseNumberOption(arg, value, 1, options.topK)) return false; }
+        else if (arg == "--format") options.format = value;
+        else if (arg == "--output") options.output = value;
+        else if (arg == "--job-stats") options.jobStatsOutput = value;
+        else if (arg == "--stream") { if (!parseNumberOption(arg, value, 0, options.streamBatch)) return false; }
+        else if (arg == "--metrics") options.metricsOutput = value;
+        else if (arg == "--taxonomy") options.taxonomy = value;
+        else if (arg == "--match") options.matchMode = value;
+        else {
+            cerr << "Error: unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    if (options.algorithm != "keyword" && options.algorithm != "weighted") {
+        cerr << "Error: --algorithm must be keyword or weighted\n";
+        return false;
+    }
+    if (options.format != "csv" && options.format != "json") {
+        cerr << "Error: --format must be csv or json\n";
+        return false;
+    }
+    SkillMatchMode mode;
+    if (!options.matchMode.empty() && !parseSkillMatchMode(options.matchMode, mode)) {
+        cerr << "Error: --match must be words or substrings\n";
+        return false;
+    }
+    if (options.format == "json" && (options.streamBatch > 0 || !options.jobStatsOutput.empty())) {
+        cerr << "Error: --stream and --job-stats write CSV only\n";
+        return false;
+    }
+    return true;
+}
+
+inline const char* matchOutcomeName(MatchOutcome outcome) {
+    switch (outcome) {
+        case MATCH_FOUND: return "found";
+        case MATCH_NONE: return "none";
+        case MATCH_BELOW_THRESHOLD: return "below_threshold";
+        default: return "pending";
+    }
+}
+
+inline void writeMatchesCsv(ostream& out, const ResumeColumns& resumeCols) {
+    out << "ResumeID,BestJobID,Score\n";
+    for (ResumeNode* resume : resumeCols)
+        out << resume->id << ',' << resume->getBestJobId() << ',' << resume->bestMatchScore << '\n';
+}
+
+inline void writeJobStatsCsv(ostream& out, const JobColumns& jobCols) {
+    out << "JobID,TotalMatches,TotalScore,AverageScore\n";
+    for (int j = 0; j < jobCols.size(); ++j) {
+        const JobNode* job = jobCols.node(j);
+        out << job->id << ',' << job->totalMatches << ',' << job->totalScore << ',' << job->averageScore << '\n';
+    }
+}
+
+// The same columns from the totals streamMatchResumes gathered
+inline void writeStreamJobStatsCsv(ostream& out, const JobColumns& jobCols, const StreamSummary& summary) {
+    out << "JobID,TotalMatches,TotalScore,AverageScore\n";
+    for (int j = 0; j < jobCols.size(); ++j)
+        out << jobCols.node(j)->id << ',' << summary.jobMatches[j] << ',' << summary.jobScores[j] << ','
+            << streamedAverage(summary, j) << '\n';
+}
+
+// {"algorithm": ..., "resumes": [...], "jobs": [...]}; IDs are generated by
+// the loaders and never need escaping
+inline void writeResultsJson(ostream& out, const string& algorithm,
+                             const ResumeColumns& resumeCols, const JobColumns& jobCols) {
+    out << "{\"algorithm\":\"" << algorithm << "\",\"resumes\":[";
+    for (int r = 0; r < resumeCols.size(); ++r) {
+        const ResumeNode* resume = resumeCols.node(r);
+        out << (r > 0 ? ",\n" : "\n") << "{\"id\":\"" << resume->id << "\",\"outcome\":\""
+            << matchOutcomeName(resume->matchOutcome) << "\",\"bestJob\":";
+        if (resume->matchOutcome == MATCH_FOUND) out << '"' << resume->getBestJobId() << '"';
+        else out << "null";
+        out << ",\"score\":" << resume->bestMatchScore;
+        if (resumeCols.topK > 1) {
+            out << ",\"recommendations\":[";
+            for (int rank = 0; rank < resumeCols.topK; ++rank) {
+                int job = resumeCols.topJob(r, rank);
+                if (job < 0) break;
+                out << (rank > 0 ? "," : "") << "{\"job\":\"" << jobCols.node(job)->id
+                    << "\",\"score\":" << resumeCols.topScore(r, rank) << '}';
+            }
+            out << ']';
+        }
+        out << '}';
+    }
+    out << "\n],\"jobs\":[";
+    for (int j = 0; j < jobCols.size(); ++j) {
+        const JobNode* job = jobCols.node(j);
+        out << (j > 0 ? ",\n" : "\n") << "{\"id\":\"" << job->id << "\",\"totalMatches\":" << job->totalMatches
+            << ",\"totalScore\":" << job->totalScore << ",\"averageScore\":" << job->averageScore << '}';
+    }
+    out << "\n]}\n";
+}
+
+template <typename Algorithm>
+inline bool runBatchWith(Algorithm& algorithm, const BatchOptions& options, ostream& out) {
+    algorithm.setThreadCount(options.threads);
+    algorithm.setTopK(options.topK);
+
+    JobLinkedList jobs;
+    if (!loadJobsFromCSV(options.jobCsv, jobs, options.threads)) return false;
+    JobColumns& jobCols = jobs.getColumns();
+
+    ResumeLinkedList resumes;
+    StreamSummary summary;
+    if (options.streamBatch > 0) {
+        if (!streamMatchResumes(options.resumeCsv, jobs, algorithm, out, options.streamBatch, summary)) return false;
+        cerr << "Streamed " << summary.resumes << " resumes in " << summary.batches << " batch(es), skipped "
+             << summary.skipped << ", in " << summary.seconds << " seconds.\n";
+    } else {
+        if (!loadResumesFromCSV(options.resumeCsv, resumes, options.threads)) return false;
+        algorithm.prepareJobs(jobs);
+        algorithm.matchResumes(resumes, jobCols);
+        calculateJobStats(jobCols, resumes.getColumns(), options.threads);
+
+        if (options.format == "json") writeResultsJson(out, options.algorithm, resumes.getColumns(), jobCols);
+        else writeMatchesCsv(out, resumes.getColumns());
+    }
+
+    if (!options.jobStatsOutput.empty()) {
+        BufferedFileWriter statsFile;
+        if (!statsFile.open(options.jobStatsOutput)) {
+            cerr << "Error: Could not create " << options.jobStatsOutput << endl;
+            return false;
+        }
+        ostream stats(&statsFile);
+        if (options.streamBatch > 0) writeStreamJobStatsCsv(stats, jobCols, summary);
+        else writeJobStatsCsv(stats, jobCols);
+        if (!statsFile.close()) return false;
+    }
+    return true;
+}
+
+// Returns the process exit code
+inline int runBatch(int argc, char** argv) {
+    BatchOptions options;
+    if (!parseBatchArguments(argc, argv, options)) {
+        printBatchUsage();
+        return 2;
+    }
+
+    if (!options.taxonomy.empty() || !options.matchMode.empty()) {
+        TaxonomySource source = defaultTaxonomySource();
+        string error;
+        bool loaded = options.taxonomy.empty() || parseTaxonomyFile(options.taxonomy, source, error);
+        if (loaded && !options.matchMode.empty()) parseSkillMatchMode(options.matchMode, source.matchMode);
+        if (loaded && !installTaxonomy(source, error)) {
+            error = source.origin + ": " + error;
+            loaded = false;
+        }
+        if (!loaded) {
+            cerr << "Error: " << error << endl;
+            return 2;
+        }
+    }
+
+    // Loader progress would otherwise mix with results written to stdout
+    streambuf* console = cout.rdbuf(cerr.rdbuf());
+    if (!options.metricsOutput.empty()) MetricsRegistry::instance().setEnabled(true);
+
+    BufferedFileWriter outputFile;
+    bool ok = outputFile.open(options.output);
+    if (!ok) cerr << "Error: Could not create " << options.output << endl;
+    if (ok) {
+        ostream out(&outputFile);
+        Stopwatch watch;
+        if (options.algorithm == "weighted") {
+            WeightedAlgorithm weighted;
+            ok = runBatchWith(weighted, options, out);
+        } else {
+            KeywordAlgorithm keyword;
+            ok = runBatchWith(keyword, options, out);
+        }
+        ok = outputFile.close() && ok;
+        cerr << "Batch " << (ok ? "completed" : "failed") << " in " << watch.elapsed() << " seconds.\n";
+    }
+
+    if (!options.metricsOutput.empty()) {
+        ofstream metricsFile(options.metricsOutput);
+        const string& path = options.metricsOutput;
+        bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+        if (csv) MetricsRegistry::instance().exportCsv(metricsFile);
+        else MetricsRegistry::instance().exportJson(metricsFile);
+        if (!metricsFile) {
+            cerr << "Error: Could not write " << path << endl;
+            ok = false;
+        }
+    }
+
+    cout.rdbuf(console);
+    return ok ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,363 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "LinkedListNodes.hpp"
+#include "MatchingAlgorithm.hpp"
+#include "BatchMode.hpp"
+#include "SyntheticData.hpp"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// The original linked-list implementation, kept as the baseline. Its lists
+// share names with ours, so it gets a namespace, and its main() is renamed.
+// Every header it includes has already been included above.
+namespace reference {
+#define main referenceMain
+#include "ReferenceVersion.C++"
+#undef main
+}
+
+using namespace std;
+
+// Times each phase of a matching run on synthetic corpora and prints one
+// machine-readable record per algorithm and size:
+//
+//   g++ -std=c++17 -O2 -pthread Benchmark.c++ -o benchmark
+//   ./benchmark --sizes 1000,10000,100000 --threads 0 --format csv
+//
+// Phases: load (CSV into the lists), preprocess (skill extraction and the
+// job-side search structures), match, aggregate (job stats) and top10 (first
+// ranking query). The reference JobMatcher has no separate preprocess,
+// aggregate or ranking step; those are reported as null. Its matcher walks
+// both lists for every pair, so it only runs up to --reference-max records.
+// It finds skills as substrings; --match substrings makes the other two do so.
+
+struct BenchmarkOptions {
+    vector<int> sizes = {1000, 10000};
+    int jobs = 0;                 // 0 = as many jobs as resumes
+    int threads = 1;
+    int topK = 1;
+    int referenceMax = 2000;
+    bool runKeyword = true;
+    bool runWeighted = true;
+    bool runReference = true;
+    bool generateOnly = false;
+    string format = "json";
+    string output;                // empty = stdout
+    string dataDir = ".";
+    SkillMatchMode matchMode = SKILL_MATCH_WORDS;
+    SyntheticCorpusOptions corpus;
+};
+
+struct BenchmarkResult {
+    string algorithm;
+    int jobs = 0;
+    int resumes = 0;
+    double load = 0, preprocess = 0, match = 0, aggregate = 0, top10 = 0;
+    bool hasStages = true;        // false when only load and match apply
+    size_t listBytes = 0;
+    long peakRssBytes = 0;
+};
+
+// Discards everything written to it; silences the loaders and the reference
+// matcher's per-resume printout while they are timed
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+// High-water mark of the whole process, so it only grows from run to run
+inline long peakRssBytes() {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024L;
+#endif
+#endif
+}
+
+template <typename Algorithm>
+BenchmarkResult runOptimized(const string& name, Algorithm& algorithm,
+                             const string& jobCsv, const string& resumeCsv, const BenchmarkOptions& options) {
+    BenchmarkResult result;
+    result.algorithm = name;
+    algorithm.setThreadCount(options.threads);
+    algorithm.setTopK(options.topK);
+
+    JobLinkedList jobs;
+    ResumeLinkedList resumes;
+    Stopwatch watch;
+    loadJobsFromCSV(jobCsv, jobs, options.threads);
+    loadResumesFromCSV(resumeCsv, resumes, options.threads);
+    result.load = watch.lap();
+
+    algorithm.prepareJobs(jobs);
+    preprocessResumeSkills(resumes);
+    result.preprocess = watch.lap();
+
+    JobColumns& jobCols = jobs.getColumns();
+    algorithm.matchResumes(resumes, jobCols);
+    result.match = watch.lap();
+
+    calculateJobStats(jobCols, resumes.getColumns(), options.threads);
+    result.aggregate = watch.lap();
+
+    vector<JobNode*> top = jobs.getRankedJobs(RANK_BY_AVERAGE_SCORE, 0, 10);
+    result.top10 = watch.lap();
+
+    result.jobs = jobs.getSize();
+    result.resumes = resumes.getSize();
+    result.listBytes = jobs.getTotalMemoryUsage() + resumes.getTotalMemoryUsage();
+    result.peakRssBytes = peakRssBytes();
+    return result;
+}
+
+// Loads the reference lists the way its loader does, one line at a time with
+// a tail walk per insert, but with generated IDs: its own loader splits the
+// quoted description at the first comma and would overflow the 20-byte ID.
+inline int loadReferenceList(const string& path, char prefix,
+                             reference::JobLinkedList* jobs, reference::ResumeLinkedList* resumes) {
+    ifstream file(path);
+    string line;
+    getline(file, line);   // header
+    int count = 0;
+    while (getline(file, line)) {
+        string_view text = trim(line);
+        if (text.size() >= 2 && text.front() == '"' && text.back() == '"') text = text.substr(1, text.size() - 2);
+        if (text.empty()) continue;
+        string description(text.substr(0, 999));   // its nodes hold char[1000]
+        string id = makeRecordId(prefix, ++count);
+        if (jobs != nullptr) jobs->addJob(id.c_str(), description.c_str());
+        else resumes->addResume(id.c_str(), description.c_str());
+    }
+    return count;
+}
+
+inline BenchmarkResult runReference(const string& jobCsv, const string& resumeCsv) {
+    BenchmarkResult result;
+    result.algorithm = "reference";
+    result.hasStages = false;
+
+    reference::JobLinkedList jobs;
+    reference::ResumeLinkedList resumes;
+    Stopwatch watch;
+    result.jobs = loadReferenceList(jobCsv, 'J', &jobs, nullptr);
+    result.resumes = loadReferenceList(resumeCsv, 'R', nullptr, &resumes);
+    result.load = watch.lap();
+
+    reference::JobMatcher matcher;
+    matcher.matchJobsLinkedList(jobs, resumes);
+    result.match = watch.lap();
+
+    // Fixed-size nodes: id[20], description[1000] and the next pointer
+    const size_t nodeBytes = 20 + 1000 + sizeof(void*);
+    result.listBytes = (size_t)(result.jobs + result.resumes) * nodeBytes;
+    result.peakRssBytes = peakRssBytes();
+    return result;
+}
+
+// --- Output ---
+
+inline void writeHeader(ostream& out, const string& format) {
+    if (format == "csv")
+        out << "algorithm,jobs,resumes,threads,load_s,preprocess_s,match_s,aggregate_s,top10_s,total_s,"
+               "pairs_per_s,resumes_per_s,list_bytes,peak_rss_bytes\n";
+}
+
+inline void writeResult(ostream& out, const BenchmarkResult& r, const BenchmarkOptions& options) {
+    const double total = r.load + r.preprocess + r.match + r.aggregate + r.top10;
+    const double pairs = (double)r.jobs * r.resumes;
+    const double pairsPerSecond = r.match > 0 ? pairs / r.match : 0.0;
+    const double resumesPerSecond = r.match > 0 ? r.resumes / r.match : 0.0;
+    const bool csv = options.format == "csv";
+    const char* missing = csv ? "" : "null";
+    auto stage = [&](double seconds) { return r.hasStages ? to_string(seconds) : string(missing); };
+
+    if (csv) {
+        out << r.algorithm << ',' << r.jobs << ',' << r.resumes << ',' << options.threads << ','
+            << to_string(r.load) << ',' << stage(r.preprocess) << ',' << to_string(r.match) << ','
+            << stage(r.aggregate) << ',' << stage(r.top10) << ',' << to_string(total) << ','
+            << to_string(pairsPerSecond) << ',' << to_string(resumesPerSecond) << ','
+            << r.listBytes << ',' << r.peakRssBytes << '\n';
+    } else {
+        out << "{\"algorithm\":\"" << r.algorithm << "\",\"jobs\":" << r.jobs << ",\"resumes\":" << r.resumes
+            << ",\"threads\":" << options.threads
+            << ",\"load_s\":" << to_string(r.load) << ",\"preprocess_s\":" << stage(r.preprocess)
+            << ",\"match_s\":" << to_string(r.match) << ",\"aggregate_s\":" << stage(r.aggregate)
+            << ",\"top10_s\":" << stage(r.top10) << ",\"total_s\":" << to_string(total)
+            << ",\"pairs_per_s\":" << to_string(pairsPerSecond) << ",\"resumes_per_s\":" << to_string(resumesPerSecond)
+            << ",\"list_bytes\":" << r.listBytes << ",\"peak_rss_bytes\":" << r.peakRssBytes << "}\n";
+    }
+    out.flush();
+}
+
+// --- Command line ---
+
+inline void printUsage() {
+    cerr << "Usage: benchmark [options]\n"
+            "  --sizes N,N,...       resumes per run, 1000 to 1000000 (default 1000,10000)\n"
+            "  --jobs N              jobs per run (default: same as resumes)\n"
+            "  --min-skills N        skills per description, lower bound (default 4)\n"
+            "  --max-skills N        skills per description, upper bound (default 8)\n"
+            "  --noise N             non-skill words in each resume's skill list (default 2)\n"
+            "  --seed N              generator seed (default 42)\n"
+            "  --threads N           matching threads, 0 = all cores (default 1)\n"
+            "  --top-k N             recommendations per resume (default 1)\n"
+            "  --algorithms LIST     keyword,weighted,reference (default all)\n"
+            "  --reference-max N     largest size the reference matcher runs on (default 2000)\n"
+            "  --format json|csv     one JSON object per line, or CSV with a header (default json)\n"
+            "  --output FILE         write results to FILE instead of stdout\n"
+            "  --data-dir DIR        where the generated CSVs are written (default .)\n"
+            "  --match MODE          words (default) or substrings, to find skills in descriptions\n"
+            "  --generate-only       write the CSVs and exit\n";
+}
+
+// Every comma-separated size must be a whole number of at least 1
+inline bool parseSizeList(const string& arg, const string& text, vector<int>& sizes) {
+    sizes.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        int value;
+        if (!parseNumberOption(arg, item, 1, value)) return false;
+        sizes.push_back(value);
+    }
+    return true;
+}
+
+inline bool parseArguments(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") return false;
+        if (arg == "--generate-only") {
+            options.generateOnly = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: " << arg << " needs a value\n";
+            return false;
+        }
+        string value = argv[++i];
+        bool parsed = true;
+        int seed = 0;
+        if (arg == "--sizes") parsed = parseSizeList(arg, value, options.sizes);
+        else if (arg == "--jobs") parsed = parseNumberOption(arg, value, 0, options.jobs);
+        else if (arg == "--min-skills") parsed = parseNumberOption(arg, value, 1, options.corpus.minSkills);
+        else if (arg == "--max-skills") parsed = parseNumberOption(arg, value, 1, options.corpus.maxSkills);
+        else if (arg == "--noise") parsed = parseNumberOption(arg, value, 0, options.corpus.noiseWords);
+        else if (arg == "--seed") {
+            parsed = parseNumberOption(arg, value, 0, seed);
+            options.corpus.seed = (unsigned)seed;
+        }
+        else if (arg == "--threads") parsed = parseNumberOption(arg, value, 0, options.threads);
+        else if (arg == "--top-k") parsed = parseNumberOption(arg, value, 1, options.topK);
+        else if (arg == "--reference-max") parsed = parseNumberOption(arg, value, 0, options.referenceMax);
+        else if (arg == "--format") options.format = value;
+        else if (arg == "--output") options.output = value;
+        else if (arg == "--data-dir") options.dataDir = value;
+        else if (arg == "--match") {
+            if (!parseSkillMatchMode(value, options.matchMode)) {
+                cerr << "Error: --match must be words or substrings\n";
+                return false;
+            }
+        }
+        else if (arg == "--algorithms") {
+            options.runKeyword = value.find("keyword") != string::npos;
+            options.runWeighted = value.find("weighted") != string::npos;
+            options.runReference = value.find("reference") != string::npos;
+        } else {
+            cerr << "Error: unknown option " << arg << "\n";
+            return false;
+        }
+        if (!parsed) return false;
+    }
+    if (options.sizes.empty() || (options.format != "json" && options.format != "csv")) {
+        cerr << "Error: invalid option value\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    TaxonomySource taxonomy = defaultTaxonomySource();
+    taxonomy.matchMode = options.matchMode;
+    string error;
+    if (!installTaxonomy(taxonomy, error)) {
+        cerr << "Error: " << error << endl;
+        return 1;
+    }
+
+    ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file.is_open()) {
+            cerr << "Error: Could not create " << options.output << endl;
+            return 1;
+        }
+    }
+    // Results go to the real stdout (or the file); cout itself is muted during runs
+    streambuf* console = cout.rdbuf();
+    ostream out(options.output.empty() ? console : file.rdbuf());
+    NullBuffer discard;
+    if (!options.generateOnly) writeHeader(out, options.format);
+
+    for (int size : options.sizes) {
+        const int jobCount = options.jobs > 0 ? options.jobs : size;
+        const string tag = to_string(options.corpus.minSkills) + "-" + to_string(options.corpus.maxSkills)
+                         + "_" + to_string(options.corpus.seed);
+        const string jobCsv = options.dataDir + "/bench_jobs_" + to_string(jobCount) + "_" + tag + ".csv";
+        const string resumeCsv = options.dataDir + "/bench_resumes_" + to_string(size) + "_" + tag + ".csv";
+
+        SyntheticCorpusOptions corpus = options.corpus;
+        corpus.records = jobCount;
+        if (!SyntheticCorpusGenerator(corpus).writeJobs(jobCsv)) {
+            cerr << "Error: Could not create " << jobCsv << endl;
+            return 1;
+        }
+        corpus.records = size;
+        if (!SyntheticCorpusGenerator(corpus).writeResumes(resumeCsv)) {
+            cerr << "Error: Could not create " << resumeCsv << endl;
+            return 1;
+        }
+        cerr << "Generated " << jobCount << " jobs and " << size << " resumes\n";
+        if (options.generateOnly) continue;
+
+        cout.rdbuf(&discard);
+        if (options.runKeyword) {
+            KeywordAlgorithm keyword;
+            writeResult(out, runOptimized("keyword", keyword, jobCsv, resumeCsv, options), options);
+        }
+        if (options.runWeighted) {
+            WeightedAlgorithm weighted;
+            writeResult(out, runOptimized("weighted", weighted, jobCsv, resumeCsv, options), options);
+        }
+        if (options.runReference) {
+            if (max(size, jobCount) <= options.referenceMax) {
+                writeResult(out, runReference(jobCsv, resumeCsv), options);
+            } else {
+                cerr << "Skipping reference matcher above " << options.referenceMax << " records\n";
+            }
+        }
+        cout.rdbuf(console);
+    }
+    return 0;
+}
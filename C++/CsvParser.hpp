@@ -0,0 +1,269 @@
+#ifndef CSV_PARSER_HPP
+#define CSV_PARSER_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+#include <array>
+#include "ThreadPool.hpp"
+using namespace std;
+
+// Inputs smaller than this per thread are not worth splitting
+static const size_t CSV_MIN_CHUNK_BYTES = 256 * 1024;
+
+// Job and resume files have one column: a record is a whole description,
+// commas included, as when the files were read line by line. Quotes only
+// matter at the start of a record. A record that is a single quoted field may
+// span lines and is unquoted, with "" folded to "; any other record, such as
+// an unquoted line or a quoted field followed by more text, is kept as is.
+enum CsvState {
+    CSV_RECORD_START,   // at the first byte of a record
+    CSV_UNQUOTED,       // in a record that did not start with a quote; ends at '\n'
+    CSV_QUOTED,         // inside quotes
+    CSV_AFTER_QUOTE     // in a quoted record, past a quote that may close it
+};
+
+struct CsvStateTable {
+    unsigned char next[4][256];
+
+    constexpr CsvStateTable() : next() {
+        for (int c = 0; c < 256; ++c) {
+            next[CSV_RECORD_START][c] = c == '"' ? CSV_QUOTED : c == '\n' ? CSV_RECORD_START : CSV_UNQUOTED;
+            next[CSV_UNQUOTED][c] = c == '\n' ? CSV_RECORD_START : CSV_UNQUOTED;
+            next[CSV_QUOTED][c] = c == '"' ? CSV_AFTER_QUOTE : CSV_QUOTED;
+            next[CSV_AFTER_QUOTE][c] = c == '"' ? CSV_QUOTED : c == '\n' ? CSV_RECORD_START : CSV_AFTER_QUOTE;
+        }
+    }
+};
+
+static constexpr CsvStateTable CSV_TRANSITIONS{};
+
+// Scans from p in `state` and returns the byte after the newline that ends the
+// record, or nullptr when [p, end) runs out first; `state` is then the state
+// at `end`, so the scan can resume there once more data arrives.
+inline char* findCsvRecordEnd(char* p, char* end, int& state) {
+    while (p < end) {
+        if (state == CSV_UNQUOTED) {
+            char* newline = (char*)memchr(p, '\n', end - p);
+            if (newline == nullptr) break;
+            state = CSV_RECORD_START;
+            return newline + 1;
+        }
+        if (state == CSV_QUOTED) {
+            char* quote = (char*)memchr(p, '"', end - p);
+            if (quote == nullptr) break;
+            state = CSV_AFTER_QUOTE;
+            p = quote + 1;
+            continue;
+        }
+        state = CSV_TRANSITIONS.next[state][(unsigned char)*p++];
+        if (state == CSV_RECORD_START) return p;
+    }
+    return nullptr;
+}
+
+// State at `end` after scanning [p, end) from `state`
+inline int advanceCsvState(char* p, char* end, int state) {
+    while ((p = findCsvRecordEnd(p, end, state)) != nullptr) {}
+    return state;
+}
+
+// The record [p, end), without its newline, unquoted when it is a single
+// quoted field. Unquoting folds "" in place, so the buffer must be writable.
+inline string_view csvRecordText(char* p, char* end) {
+    if (end > p && end[-1] == '\n') --end;
+    if (p == end || *p != '"') return string_view(p, end - p);
+
+    // The closing quote is the first one not followed by another
+    char* close = p + 1;
+    char* escape = nullptr;   // first "" pair, where text starts to shift
+    for (;;) {
+        close = (char*)memchr(close, '"', end - close);
+        if (close == nullptr) {
+            close = end;   // unterminated: the field runs to the end of the input
+            break;
+        }
+        if (close + 1 == end || close[1] != '"') break;
+        if (escape == nullptr) escape = close;
+        close += 2;
+    }
+    for (char* rest = (close < end) ? close + 1 : end; rest < end; ++rest)
+        if (*rest != ' ' && *rest != '\t' && *rest != '\r') return string_view(p, end - p);
+    if (escape == nullptr) return string_view(p + 1, close - (p + 1));
+
+    char* write = escape;
+    for (char* read = escape; read < close; ++read) {
+        *write++ = *read;
+        if (*read == '"') ++read;   // the second quote of ""
+    }
+    return string_view(p + 1, write - (p + 1));
+}
+
+// Parses the record starting at p and returns the start of the next one
+inline char* parseCsvRecord(char* p, char* end, string_view& record) {
+    int state = CSV_RECORD_START;
+    char* stop = findCsvRecordEnd(p, end, state);
+    if (stop == nullptr) stop = end;
+    record = csvRecordText(p, stop);
+    return stop;
+}
+
+// Splits [begin, end) into up to `parts` ranges that each start on a record.
+// Whether a byte starts a record depends on everything before it, so each
+// range is first scanned in parallel from each of the four CsvStates; chaining
+// those end states from the start of the input gives the true state at every
+// range start, and each boundary then moves forward to the next record.
+inline vector<char*> splitCsvRecords(char* begin, char* end, int parts, WorkStealingPool& pool) {
+    const size_t length = end - begin;
+    vector<char*> starts(parts + 1);
+    for (int c = 0; c <= parts; ++c) starts[c] = begin + (size_t)((unsigned long long)length * c / parts);
+
+    vector<array<int, 4>> endStates(parts);
+    pool.parallelFor(parts, 1, [&](int first, int last, int) {
+        for (int c = first; c < last; ++c)
+            for (int s = 0; s < 4; ++s) endStates[c][s] = advanceCsvState(starts[c], starts[c + 1], s);
+    });
+
+    vector<int> startState(parts);
+    int state = CSV_RECORD_START;
+    for (int c = 0; c < parts; ++c) {
+        startState[c] = state;
+        state = endStates[c][state];
+    }
+
+    vector<char*> boundaries(parts + 1);
+    boundaries[0] = begin;
+    boundaries[parts] = end;
+    pool.parallelFor(parts - 1, 1, [&](int first, int last, int) {
+        for (int c = first + 1; c < last + 1; ++c) {
+            int s = startState[c];
+            if (s == CSV_RECORD_START) {
+                boundaries[c] = starts[c];
+                continue;
+            }
+            char* next = findCsvRecordEnd(starts[c], end, s);
+            boundaries[c] = (next != nullptr) ? next : end;
+        }
+    });
+    for (int c = 1; c <= parts; ++c)
+        if (boundaries[c] < boundaries[c - 1]) boundaries[c] = boundaries[c - 1];
+    return boundaries;
+}
+
+// Every record after the header row, in file order. Chunks
+// are parsed on up to `threadCount` threads (0 = all cores) and concatenated
+// in order, so the result does not depend on the thread count.
+inline vector<string_view> parseCsvRecords(char* data, size_t size, int threadCount) {
+    vector<string_view> records;
+    if (data == nullptr || size == 0) return records;
+
+    char* end = data + size;
+    string_view header;
+    char* body = parseCsvRecord(data, end, header);
+    if (body >= end) return records;
+
+    WorkStealingPool pool(threadCount);
+    const size_t bodyBytes = end - body;
+    size_t maxParts = bodyBytes / CSV_MIN_CHUNK_BYTES;
+    int parts = pool.getThreadCount();
+    if ((size_t)parts > maxParts) parts = maxParts > 0 ? (int)maxParts : 1;
+
+    vector<char*> boundaries = splitCsvRecords(body, end, parts, pool);
+    vector<vector<string_view>> chunks(parts);
+    pool.parallelFor(parts, 1, [&](int first, int last, int) {
+        for (int c = first; c < last; ++c) {
+            string_view record;
+            for (char* p = boundaries[c]; p < boundaries[c + 1]; ) {
+                p = parseCsvRecord(p, boundaries[c + 1], record);
+                chunks[c].push_back(record);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& chunk : chunks) total += chunk.size();
+    records.reserve(total);
+    for (const auto& chunk : chunks) records.insert(records.end(), chunk.begin(), chunk.end());
+    return records;
+}
+
+// Reads a CSV file of any size record by record through one fixed buffer,
+// for inputs that should not be held in memory as a whole. The buffer only
+// grows when a single record does not fit in it.
+class CsvStreamReader {
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t begin;   // first unread byte, always the start of a record
+    size_t end;     // end of the buffered data
+    size_t scanned; // the record at `begin` is scanned up to here, ending in scanState
+    int scanState;
+    bool atEof;
+
+    void refill() {
+        if (begin > 0) {
+            memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            scanned -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+        size_t got = fread(buffer.data() + end, 1, buffer.size() - end, file);
+        end += got;
+        if (got == 0) atEof = true;
+    }
+
+public:
+    CsvStreamReader() : file(nullptr), begin(0), end(0), scanned(0), scanState(CSV_RECORD_START), atEof(true) {}
+    ~CsvStreamReader() { close(); }
+
+    CsvStreamReader(const CsvStreamReader&) = delete;
+    CsvStreamReader& operator=(const CsvStreamReader&) = delete;
+
+    bool open(const string& path, size_t bufferBytes = 4 << 20) {
+        close();
+        file = fopen(path.c_str(), "rb");
+        if (file == nullptr) return false;
+        buffer.assign(bufferBytes < 4096 ? 4096 : bufferBytes, 0);
+        begin = end = scanned = 0;
+        scanState = CSV_RECORD_START;
+        atEof = false;
+        return true;
+    }
+
+    void close() {
+        if (file != nullptr) fclose(file);
+        file = nullptr;
+        atEof = true;
+    }
+
+    // Next record, unquoted like parseCsvRecord; false at the end of the
+    // file. The view is valid until the next call. A record longer than the
+    // buffer is scanned once, resuming where the last refill stopped.
+    bool next(string_view& record) {
+        for (;;) {
+            char* data = buffer.data();
+            if (begin < end) {
+                char* stop = findCsvRecordEnd(data + scanned, data + end, scanState);
+                if (stop != nullptr || atEof) {
+                    if (stop == nullptr) stop = data + end;
+                    record = csvRecordText(data + begin, stop);
+                    begin = scanned = stop - data;
+                    scanState = CSV_RECORD_START;
+                    return true;
+                }
+                scanned = end;
+            } else if (atEof) {
+                return false;
+            }
+            refill();
+        }
+    }
+
+    size_t getBufferSize() const { return buffer.size(); }
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef ID_INDEX_HPP
+#define ID_INDEX_HPP
+
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// Hash index from the numeric part of an ID ("J042" -> 42) to its node, using
+// open addressing with linear probing. Keys are kept alongside the node
+// pointers so a probe only touches one dense array.
+template <typename Node>
+class IdHashIndex {
+private:
+    struct Slot {
+        int key;
+        Node* node;   // nullptr = empty
+    };
+
+    vector<Slot> slots;
+    int count;
+
+    static size_t hashKey(int key) {
+        uint64_t h = (uint64_t)(uint32_t)key * 0x9E3779B97F4A7C15ULL;
+        return (size_t)(h >> 32);
+    }
+
+    size_t findSlot(int key) const {
+        const size_t mask = slots.size() - 1;
+        size_t slot = hashKey(key) & mask;
+        while (slots[slot].node != nullptr && slots[slot].key != key)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow() {
+        vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.empty() ? 16 : old.size() * 2, Slot{0, nullptr});
+        for (const Slot& s : old)
+            if (s.node != nullptr) slots[findSlot(s.key)] = s;
+    }
+
+public:
+    IdHashIndex() : count(0) {}
+
+    int size() const { return count; }
+
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+    // Maps key to node. With `replace` false an existing entry is kept, so the
+    // earliest node in list order stays the one found for a duplicated ID.
+    void insert(int key, Node* node, bool replace) {
+        if (key < 0) return;
+        if ((size_t)(count + 1) * 2 > slots.size()) grow();
+        size_t slot = findSlot(key);
+        if (slots[slot].node == nullptr) {
+            slots[slot] = Slot{key, node};
+            count++;
+        } else if (replace) {
+            slots[slot].node = node;
+        }
+    }
+
+    Node* find(int key) const {
+        if (key < 0 || slots.empty()) return nullptr;
+        return slots[findSlot(key)].node;
+    }
+
+    size_t getMemoryUsage() const { return slots.capacity() * sizeof(Slot); }
+};
+
+#endif
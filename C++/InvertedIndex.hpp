@@ -0,0 +1,196 @@
+#ifndef INVERTED_INDEX_HPP
+#define INVERTED_INDEX_HPP
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "SkillVector.hpp"
+#include "SkillTaxonomy.hpp"
+#include "TopK.hpp"
+using namespace std;
+
+// Per-worker visited marks, reset in O(1) by bumping the epoch
+struct IndexScratch {
+    vector<uint32_t> seen;
+    uint32_t epoch = 0;
+    uint64_t scored = 0;   // jobs scored by the searches using it, for the metrics
+
+    void prepare(int jobCount) {
+        if ((int)seen.size() != jobCount) {
+            seen.assign(jobCount, 0);
+            epoch = 0;
+        }
+    }
+
+    uint32_t nextEpoch() {
+        if (++epoch == 0) {
+            fill(seen.begin(), seen.end(), 0);
+            epoch = 1;
+        }
+        return epoch;
+    }
+};
+
+// Inverted index from skill bit to the jobs that list it. Posting lists are
+// stored back to back (CSR layout) and sorted by job index, so a best-job
+// search visits only jobs sharing a skill with the resume and can cut a list
+// short once the remaining jobs are known to lose the first-job-wins tie-break.
+class InvertedSkillIndex {
+private:
+    static const int BIT_COUNT = 64;
+    static const int NO_POSSIBLE = 1 << 30;
+
+    int jobCount;
+    vector<int> offsets;            // BIT_COUNT + 1 entries
+    vector<int> postings;
+    vector<SkillMask> masks;        // the indexed mask of every job
+    vector<int> possible;           // weighted mode: points each job is worth
+    BitWeights points = DEFAULT_TIER_LAYOUT.points;   // weighted mode: from the tier layout
+    int minJobPoints = DEFAULT_TIER_LAYOUT.minJobPoints;
+    int minPossible[BIT_COUNT];     // weighted mode: smallest usable jobPossible per list
+
+    void buildPostings() {
+        offsets.assign(BIT_COUNT + 1, 0);
+        for (int j = 0; j < jobCount; ++j)
+            for (SkillMask m = masks[j]; m != 0; m &= m - 1)
+                offsets[countTrailingZeros(m) + 1]++;
+        for (int b = 0; b < BIT_COUNT; ++b) offsets[b + 1] += offsets[b];
+
+        postings.assign(offsets[BIT_COUNT], 0);
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (int j = 0; j < jobCount; ++j)
+            for (SkillMask m = masks[j]; m != 0; m &= m - 1)
+                postings[cursor[countTrailingZeros(m)]++] = j;
+    }
+
+    // Resume bits ordered by posting length, shortest first, so the long lists
+    // come last when the bound is most likely to skip them.
+    int orderTerms(SkillMask resumeMask, int* terms) const {
+        int count = 0;
+        for (SkillMask m = resumeMask; m != 0; m &= m - 1) {
+            int bit = countTrailingZeros(m);
+            int len = offsets[bit + 1] - offsets[bit];
+            int pos = count++;
+            while (pos > 0 && offsets[terms[pos - 1] + 1] - offsets[terms[pos - 1]] > len) {
+                terms[pos] = terms[pos - 1];
+                pos--;
+            }
+            terms[pos] = bit;
+        }
+        return count;
+    }
+
+public:
+    InvertedSkillIndex() : jobCount(0) {
+        for (int b = 0; b < BIT_COUNT; ++b) minPossible[b] = NO_POSSIBLE;
+    }
+
+    int getJobCount() const { return jobCount; }
+    int getPostingCount() const { return (int)postings.size(); }
+
+    void buildKeyword(const SkillMask* jobMasks, int count) {
+        jobCount = count;
+        masks.assign(jobMasks, jobMasks + count);
+        possible.clear();
+        buildPostings();
+    }
+
+    // jobMasks are TierLayout::pack() masks
+    void buildWeighted(const SkillMask* jobMasks, int count, const TierLayout& tiers) {
+        jobCount = count;
+        masks.assign(jobMasks, jobMasks + count);
+        points = tiers.points;
+        minJobPoints = tiers.minJobPoints;
+        possible.resize(count);
+        for (int j = 0; j < count; ++j) possible[j] = weighBits(points, masks[j]);
+        buildPostings();
+
+        // Jobs below the minimum points always score 0, so they never raise a bound
+        for (int b = 0; b < BIT_COUNT; ++b) {
+            minPossible[b] = NO_POSSIBLE;
+            for (int p = offsets[b]; p < offsets[b + 1]; ++p) {
+                int jp = possible[postings[p]];
+                if (jp >= minJobPoints && jp < minPossible[b]) minPossible[b] = jp;
+            }
+        }
+    }
+
+    // The k best jobs by popcount(resume & job), k being the heap's capacity;
+    // same entries and order as a full scan in list order.
+    void topKeywordJobs(SkillMask resumeMask, IndexScratch& scratch, TopKHeap<int>& heap) const {
+        int terms[BIT_COUNT];
+        const int termCount = orderTerms(resumeMask, terms);
+        const uint32_t epoch = scratch.nextEpoch();
+        uint32_t* seen = scratch.seen.data();
+
+        for (int k = 0; k < termCount; ++k) {
+            // A job first seen now shares at most the remaining terms with the resume
+            const int bound = termCount - k;
+            bool tieOnly = false;
+            if (heap.full()) {
+                if (bound < heap.worst().score) break;
+                tieOnly = (bound == heap.worst().score);
+            }
+
+            for (int p = offsets[terms[k]]; p < offsets[terms[k] + 1]; ++p) {
+                const int j = postings[p];
+                if (tieOnly && j >= heap.worst().index) break;
+                if (seen[j] == epoch) continue;
+                seen[j] = epoch;
+                scratch.scored++;
+                heap.push(popcount64(resumeMask & masks[j]), j);
+            }
+        }
+
+        // Nothing was pruned while the heap had room, so every other job scores 0
+        heap.fillWith(0, jobCount);
+    }
+
+    // The k best jobs by (matched weight / jobPossible) * 10, compared as
+    // fractions so the bound test is exact; same entries as a full scan.
+    void topWeightedJobs(SkillMask resumeMask, IndexScratch& scratch, TopKHeap<WeightedScore>& heap) const {
+        int terms[BIT_COUNT];
+        const int termCount = orderTerms(resumeMask, terms);
+
+        // Suffix sums of term weights and suffix minima of each list's jobPossible
+        int remainingWeight[BIT_COUNT + 1];
+        int remainingMinPossible[BIT_COUNT + 1];
+        remainingWeight[termCount] = 0;
+        remainingMinPossible[termCount] = NO_POSSIBLE;
+        for (int k = termCount - 1; k >= 0; --k) {
+            remainingWeight[k] = remainingWeight[k + 1] + weighBits(points, SkillMask(1) << terms[k]);
+            remainingMinPossible[k] = min(remainingMinPossible[k + 1], minPossible[terms[k]]);
+        }
+
+        const uint32_t epoch = scratch.nextEpoch();
+        uint32_t* seen = scratch.seen.data();
+
+        for (int k = 0; k < termCount; ++k) {
+            // An unseen job matches at most remainingWeight, and scores best when
+            // its jobPossible is as small as any in the remaining lists allow
+            const int boundDen = remainingMinPossible[k];
+            if (boundDen == NO_POSSIBLE) break;
+            const WeightedScore bound(min(remainingWeight[k], boundDen), boundDen);
+            bool tieOnly = false;
+            if (heap.full()) {
+                if (bound < heap.worst().score) break;
+                tieOnly = (bound == heap.worst().score);
+            }
+
+            for (int p = offsets[terms[k]]; p < offsets[terms[k] + 1]; ++p) {
+                const int j = postings[p];
+                if (tieOnly && j >= heap.worst().index) break;
+                if (seen[j] == epoch) continue;
+                seen[j] = epoch;
+                const int jobPossible = possible[j];
+                if (jobPossible < minJobPoints) continue;  // always scores 0
+                scratch.scored++;
+                heap.push(WeightedScore(weighBits(points, resumeMask & masks[j]), jobPossible), j);
+            }
+        }
+
+        heap.fillWith(WeightedScore(), jobCount);
+    }
+};
+
+#endif
@@ -7,26 +7,38 @@
 #include <string>
 #include <ctime>
 #include <algorithm>
+#include <vector>
+#include <string_view>
+#include <cstring>
+#include <cmath>
+#include "SkillVector.hpp"
+#include "TextStore.hpp"
+#include "CsvParser.hpp"
+#include "Metrics.hpp"
+#include "IdIndex.hpp"
+#include "OrderStatisticTree.hpp"
+#include "SkillTaxonomy.hpp"
 
 using namespace std;
 
-inline string trim(const string& str) {
-    if (str.empty()) return "";
+inline string_view trim(string_view str) {
+    if (str.empty()) return string_view();
     size_t start = 0;
     size_t end = str.size();
 
     while (start < end && isspace(static_cast<unsigned char>(str[start]))) start++;
     while (end > start && isspace(static_cast<unsigned char>(str[end - 1]))) end--;
 
-    return (start >= end) ? "" : str.substr(start, end - start);
+    return (start >= end) ? string_view() : str.substr(start, end - start);
 }
 
-inline string extract_skills(const string& text) {
-    if (text.empty()) return "";
+inline string_view extract_skills(string_view text) {
+    if (text.empty()) return string_view();
 
     const char* start_marker = "in ";
     const size_t marker_len = 3;
     const char end_marker = '.';
+    if (text.size() < marker_len) return string_view();
 
     size_t start_pos = string::npos;
     for (size_t i = 0; i <= text.size() - marker_len; i++) {
@@ -38,13 +50,13 @@ inline string extract_skills(const string& text) {
         }
     }
     
-    if (start_pos == string::npos) return "";
+    if (start_pos == string::npos) return string_view();
 
     size_t content_start = start_pos + marker_len;
     size_t end_pos = text.find(end_marker, content_start);
     
-    if (end_pos == string::npos || end_pos <= content_start) return "";
-    if (content_start >= text.size()) return "";
+    if (end_pos == string::npos || end_pos <= content_start) return string_view();
+    if (content_start >= text.size()) return string_view();
     
     size_t length = end_pos - content_start;
     if (length > text.size() - content_start) {
@@ -54,24 +66,210 @@ inline string extract_skills(const string& text) {
     return text.substr(content_start, length);
 }
 
+// Numeric part of a generated ID ("J042" -> 42), or -1 when there is none
+inline int idNumber(const string& id) {
+    int num = -1;
+    for (char c : id) {
+        if (isdigit(static_cast<unsigned char>(c)))
+            num = (num < 0 ? 0 : num * 10) + (c - '0');
+    }
+    return num;
+}
+
+// Canonical form of a user-typed ID: the digits are re-padded to three places
+// after the list's prefix ("j42" -> "J042"); input without digits is kept as is.
+inline string normalizeSearchId(const string& searchId, const string& prefix) {
+    string digits;
+    for (char c : searchId) if (isdigit(static_cast<unsigned char>(c))) digits.push_back(c);
+    if (digits.empty()) return searchId;
+
+    string numstr = to_string(stoi(digits));
+    while (numstr.length() < 3) numstr = "0" + numstr;
+    return prefix + numstr;
+}
+
 // Node classes
 class JobNode {
 public:
     string id;
-    string description;
-    int skills[33];
-    int criticalSkills[6];
-    int coreSkills[10];
-    int softSkills[7];
+    string_view description;   // points into the owning list's TextArena
+    SkillMask skillMask;
+    SkillMask criticalMask;
+    SkillMask coreMask;
+    SkillMask softMask;
     JobNode* next;
+    int columnIndex;   // position in JobColumns, -1 until mirrored
+    bool skillsExtracted;   // masks are current
 
     int totalMatches;
     double totalScore;
     double averageScore;
     
-    JobNode(const string& jid, const string& desc, const string& skills)
-        : id(jid), description(desc), next(nullptr),
-          totalMatches(0), totalScore(0.0), averageScore(0.0) {}
+    JobNode(const string& jid, string_view desc)
+        : id(jid), description(desc), skillMask(0),
+          criticalMask(0), coreMask(0), softMask(0), next(nullptr), columnIndex(-1),
+          skillsExtracted(false), totalMatches(0), totalScore(0.0), averageScore(0.0) {}
+};
+
+enum JobRankCriterion {
+    RANK_BY_AVERAGE_SCORE = 0,   // averageScore, then totalMatches, then ID
+    RANK_BY_TOTAL_MATCHES = 1    // totalMatches, then totalScore, then ID
+};
+
+// Struct-of-arrays mirror of a job list, in list order. The matching loops
+// scan these dense columns instead of chasing next pointers through the nodes.
+//
+// The columns also own one order-statistic tree per JobRankCriterion over the
+// flushed stats. A tree is built on the first ranking query; after that an
+// incremental run only re-keys the jobs whose stats it touched, O(log n)
+// each, and a full run drops the trees to be rebuilt on demand.
+class JobColumns {
+public:
+    vector<JobNode*> nodes;
+    vector<int> ids;
+    vector<SkillMask> skillMask;
+    vector<SkillMask> criticalMask;
+    vector<SkillMask> coreMask;
+    vector<SkillMask> softMask;
+    vector<int> totalMatches;
+    vector<double> totalScore;
+    unsigned long layoutVersion = 0;  // bumped whenever membership changes
+
+private:
+    OrderStatisticTree rankTrees[2];  // one per JobRankCriterion
+    bool rankTreeBuilt[2] = {false, false};
+    vector<int> changedJobs;          // stats changed since the last flush
+    vector<char> statsChanged;        // column index -> listed in changedJobs
+
+    // Keys compare the stats as exact fractions. Every score a job collects,
+    // keyword or weighted, is a whole multiple of 1 / the job's weighted
+    // possible points, so the total scaled by those points is an integer that
+    // does not depend on the order the total was summed in; equal averages
+    // then tie on totalMatches as documented instead of on rounding.
+    RankKey rankKey(int index, JobRankCriterion criterion) const {
+        const JobNode* job = nodes[index];
+        const TierLayout& tiers = activeTaxonomy().getTierLayout();
+        const int possible = tiers.weight(tiers.pack(criticalMask[index], coreMask[index], softMask[index]));
+        const uint64_t scale = possible > 0 ? (uint64_t)possible : 1;
+        const uint64_t units = job->totalScore > 0 ? (uint64_t)llround(job->totalScore * scale) : 0;
+        const uint64_t matches = job->totalMatches > 0 ? (uint64_t)job->totalMatches : 0;
+        if (criterion == RANK_BY_AVERAGE_SCORE) {
+            const RankValue average = matches > 0 ? RankValue{units, scale * matches} : RankValue{0, 1};
+            return RankKey{average, RankValue{matches, 1}, ids[index], index};
+        }
+        return RankKey{RankValue{matches, 1}, RankValue{units, scale}, ids[index], index};
+    }
+
+    void dropRankTrees() {
+        for (int c = 0; c < 2; ++c) {
+            rankTrees[c].clear();
+            rankTreeBuilt[c] = false;
+        }
+    }
+
+    void writeStats(int index) {
+        JobNode* job = nodes[index];
+        job->totalMatches = totalMatches[index];
+        job->totalScore = totalScore[index];
+        job->averageScore = (totalMatches[index] > 0) ? (totalScore[index] / totalMatches[index]) : 0.0;
+    }
+
+public:
+    int size() const { return (int)nodes.size(); }
+    JobNode* node(int index) const { return nodes[index]; }
+
+    vector<JobNode*>::const_iterator begin() const { return nodes.begin(); }
+    vector<JobNode*>::const_iterator end() const { return nodes.end(); }
+
+    void clear() {
+        layoutVersion++;
+        nodes.clear(); ids.clear();
+        skillMask.clear(); criticalMask.clear(); coreMask.clear(); softMask.clear();
+        totalMatches.clear(); totalScore.clear();
+        changedJobs.clear(); statsChanged.clear();
+        dropRankTrees();
+    }
+
+    void append(JobNode* job) {
+        layoutVersion++;
+        job->columnIndex = size();
+        nodes.push_back(job);
+        ids.push_back(idNumber(job->id));
+        skillMask.push_back(job->skillMask);
+        criticalMask.push_back(job->criticalMask);
+        coreMask.push_back(job->coreMask);
+        softMask.push_back(job->softMask);
+        totalMatches.push_back(job->totalMatches);
+        totalScore.push_back(job->totalScore);
+        statsChanged.push_back(0);
+        for (int c = 0; c < 2; ++c)
+            if (rankTreeBuilt[c]) rankTrees[c].update(rankKey(job->columnIndex, (JobRankCriterion)c));
+    }
+
+    void rebuild(JobNode* head) {
+        clear();
+        for (JobNode* job = head; job != nullptr; job = job->next) append(job);
+    }
+
+    // Copy the node's freshly extracted skill vectors into the columns
+    void syncSkills(int index) {
+        const JobNode* job = nodes[index];
+        skillMask[index] = job->skillMask;
+        criticalMask[index] = job->criticalMask;
+        coreMask[index] = job->coreMask;
+        softMask[index] = job->softMask;
+    }
+
+    void resetStats() {
+        fill(totalMatches.begin(), totalMatches.end(), 0);
+        fill(totalScore.begin(), totalScore.end(), 0.0);
+    }
+
+    // Records that the job's totals changed, for flushChangedStats
+    void markStatsChanged(int index) {
+        if (statsChanged[index]) return;
+        statsChanged[index] = 1;
+        changedJobs.push_back(index);
+    }
+
+    // Write the accumulated stats back to the nodes used for display
+    void flushStats() {
+        for (int i = 0; i < size(); ++i) writeStats(i);
+        for (int index : changedJobs) statsChanged[index] = 0;
+        changedJobs.clear();
+        dropRankTrees();
+    }
+
+    // Like flushStats, but only for the jobs marked since the last flush;
+    // built rankings move just those jobs instead of being rebuilt
+    void flushChangedStats() {
+        for (int index : changedJobs) {
+            writeStats(index);
+            statsChanged[index] = 0;
+            for (int c = 0; c < 2; ++c)
+                if (rankTreeBuilt[c]) rankTrees[c].update(rankKey(index, (JobRankCriterion)c));
+        }
+        changedJobs.clear();
+    }
+
+    // Ranking of the flushed stats for a criterion, built on first use
+    const OrderStatisticTree& getRankTree(JobRankCriterion criterion) {
+        if (!rankTreeBuilt[criterion]) {
+            vector<RankKey> keys(size());
+            for (int i = 0; i < size(); ++i) keys[i] = rankKey(i, criterion);
+            rankTrees[criterion].build(keys);
+            rankTreeBuilt[criterion] = true;
+        }
+        return rankTrees[criterion];
+    }
+
+    size_t getMemoryUsage() const {
+        return nodes.capacity() * sizeof(JobNode*) + ids.capacity() * sizeof(int)
+             + (skillMask.capacity() + criticalMask.capacity() + coreMask.capacity() + softMask.capacity()) * sizeof(SkillMask)
+             + totalMatches.capacity() * sizeof(int) + totalScore.capacity() * sizeof(double)
+             + changedJobs.capacity() * sizeof(int) + statsChanged.capacity()
+             + rankTrees[0].getMemoryUsage() + rankTrees[1].getMemoryUsage();
+    }
 };
 
 class JobLinkedList {
@@ -80,8 +278,17 @@ private:
     JobNode* tail;
     int size;
 
+    mutable JobColumns columns;
+    mutable bool columnsDirty;
+    IdHashIndex<JobNode> idIndex;
+    TextArena text;
+
+    // Dirty tracking for incremental matching
+    vector<JobNode*> unmatched;       // added since the last matching run
+    int frontInsertions;              // each one shifted every column index by one
+
 public:
-    JobLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+    JobLinkedList() : head(nullptr), tail(nullptr), size(0), columnsDirty(false), frontInsertions(0) {}
 
     ~JobLinkedList() {
         while (head != nullptr) {
@@ -91,18 +298,23 @@ public:
         }
     }
 
-    void addJobAtFront(const string& id, const string& description) {
-        string skills = extract_skills(description);
-        JobNode* newNode = new JobNode(id, description, skills);
+    JobNode* addJobAtFront(const string& id, string_view description) {
+        description = text.intern(description);
+        JobNode* newNode = new JobNode(id, description);
         newNode->next = head;
         head = newNode;
         if (tail == nullptr) tail = newNode;
         size++;
+        idIndex.insert(idNumber(id), newNode, true);   // the new head is now the first match
+        columnsDirty = true;  // every index shifts by one
+        unmatched.push_back(newNode);
+        frontInsertions++;
+        return newNode;
     }
 
-    void addJobAtEnd(const string& id, const string& description) {
-        string skills = extract_skills(description);
-        JobNode* newNode = new JobNode(id, description, skills);
+    JobNode* addJobAtEnd(const string& id, string_view description) {
+        description = text.intern(description);
+        JobNode* newNode = new JobNode(id, description);
         if (head == nullptr) {
             head = tail = newNode;
         } else {
@@ -110,122 +322,142 @@ public:
             tail = newNode;
         }
         size++;
+        idIndex.insert(idNumber(id), newNode, false);
+        if (!columnsDirty) columns.append(newNode);
+        unmatched.push_back(newNode);
+        return newNode;
     }
 
     int getSize() const { return size; }
     JobNode* getHead() const { return head; }
 
-    string getJobId(int index) const {
-        JobNode* current = head;
-        for (int i = 0; i < index && current != nullptr; i++) {
-            current = current->next;
+    // Storage for descriptions; a loader maps its file here so that
+    // descriptions added from the mapping are kept without copying
+    TextArena& getTextArena() { return text; }
+
+    // Jobs added since the last matching run, in insertion order. `shift` is
+    // how far every column index known to that run has moved since (one per
+    // insertion at the front). Taking them resets the tracking.
+    vector<JobNode*> takeUnmatchedJobs(int& shift) {
+        vector<JobNode*> added;
+        added.swap(unmatched);
+        shift = frontInsertions;
+        frontInsertions = 0;
+        return added;
+    }
+
+    // A full matching run has seen every job
+    void markAllMatched() {
+        unmatched.clear();
+        frontInsertions = 0;
+    }
+
+    // Dense columns in list order, rebuilt only after an insertion at the front
+    JobColumns& getColumns() const {
+        if (columnsDirty) {
+            columns.rebuild(head);
+            columnsDirty = false;
         }
-        return (current != nullptr) ? current->id : "";
+        return columns;
+    }
+
+    // Positional access through the columns, O(1) once they are in sync
+    JobNode* getJobAt(int index) const {
+        const JobColumns& cols = getColumns();
+        return (index >= 0 && index < cols.size()) ? cols.node(index) : nullptr;
+    }
+
+    string getJobId(int index) const {
+        JobNode* job = getJobAt(index);
+        return (job != nullptr) ? job->id : "";
     }
 
     string getJobDescription(int index) const {
-        JobNode* current = head;
-        for (int i = 0; i < index && current != nullptr; i++) {
-            current = current->next;
-        }
-        return (current != nullptr) ? current->description : "";
+        JobNode* job = getJobAt(index);
+        return (job != nullptr) ? string(job->description) : "";
     }
 
     JobNode* searchById(const string& searchId) const {
         if (searchId.empty()) return nullptr;
 
-        string digits;
-        for (char c : searchId) if (isdigit(static_cast<unsigned char>(c))) digits.push_back(c);
-
-        string needle;
-        if (!digits.empty()) {
-            int num = stoi(digits);
-            string numstr = to_string(num);
-            while (numstr.length() < 3) numstr = "0" + numstr;
-            needle = "J" + numstr;
-        } else {
-            needle = searchId;
-        }
+        string needle = normalizeSearchId(searchId, "J");
+        int key = idNumber(needle);
+        JobNode* hit = idIndex.find(key);
+        if (key >= 0 && (hit == nullptr || hit->id == needle)) return hit;
 
+        // IDs without digits, or one number spelled two ways ("J42" and "J042")
         for (JobNode* current = head; current != nullptr; current = current->next) {
             if (current->id == needle) return current;
         }
         return nullptr;
     }
 
+    // Jobs at ranks [offset, offset + limit) for a criterion, O(log n + limit)
+    // once the ranking is built
+    vector<JobNode*> getRankedJobs(JobRankCriterion criterion, int offset, int limit) const {
+        ScopedPhase phase("ranking");
+        JobColumns& cols = getColumns();
+        vector<int> indices = cols.getRankTree(criterion).range(offset, limit);
+        vector<JobNode*> result;
+        result.reserve(indices.size());
+        for (int index : indices) result.push_back(cols.node(index));
+        return result;
+    }
+
+    // 1-based rank of a job for a criterion, or 0 when it is not in this list
+    int getJobRank(const JobNode* job, JobRankCriterion criterion) const {
+        JobColumns& cols = getColumns();
+        if (job == nullptr || job->columnIndex < 0 || job->columnIndex >= cols.size() ||
+            cols.node(job->columnIndex) != job) return 0;
+        return cols.getRankTree(criterion).rankOf(job->columnIndex) + 1;
+    }
+
+    void displayRankingPage(JobRankCriterion criterion, int offset, int limit) const {
+        vector<JobNode*> page = getRankedJobs(criterion, offset, limit);
+        if (page.empty()) {
+            cout << "No jobs at rank " << offset + 1 << "; there are " << size << " jobs." << endl;
+            return;
+        }
+        cout << "\nJobs Ranked " << offset + 1 << "-" << offset + (int)page.size()
+             << (criterion == RANK_BY_AVERAGE_SCORE ? " by Average Match Score\n" : " by Total Matches\n");
+        cout << "------------------------------------------------------------\n";
+        for (size_t i = 0; i < page.size(); ++i) {
+            cout << offset + (int)i + 1 << ". " << page[i]->id
+                 << " | Matches: " << page[i]->totalMatches
+                 << " | Total Score: " << page[i]->totalScore
+                 << " | Avg Score: " << page[i]->averageScore << "\n";
+        }
+        cout << "------------------------------------------------------------\n";
+    }
+
     void displayTop10ByScore() const {
         if (size == 0) return;
-       
-        JobNode** jobArray = new JobNode*[size];
-        int count = 0;
-        for (JobNode* job = head; job != nullptr; job = job->next)
-            jobArray[count++] = job;
-        for (int i = 0; i < count - 1; i++) {
-            int maxIdx = i;
-            for (int j = i + 1; j < count; j++) {
-                if (jobArray[j]->averageScore > jobArray[maxIdx]->averageScore)
-                    maxIdx = j;
-            }
-            if (maxIdx != i) {
-                JobNode* temp = jobArray[i];
-                jobArray[i] = jobArray[maxIdx];
-                jobArray[maxIdx] = temp;
-            }
-        }
+
+        vector<JobNode*> top = getRankedJobs(RANK_BY_AVERAGE_SCORE, 0, 10);
         cout << "\nTop 10 Jobs by Average Match Score\n";
         cout << "--------------------------------------------\n";
-        int limit = (count < 10) ? count : 10;
-        for (int i = 0; i < limit; i++) {
-            cout << i + 1 << ". " << jobArray[i]->id
-                 << " | Avg Score: " << jobArray[i]->averageScore
-                 << " | Matches: " << jobArray[i]->totalMatches << "\n";
+        for (size_t i = 0; i < top.size(); ++i) {
+            cout << i + 1 << ". " << top[i]->id
+                 << " | Avg Score: " << top[i]->averageScore
+                 << " | Matches: " << top[i]->totalMatches << "\n";
         }
         cout << "--------------------------------------------\n";
-       
-        delete[] jobArray;
     }
 
     void displayTop10ByMatches() const {
         if (size == 0) return;
-        
-        JobNode** jobArray = new JobNode*[size];
-        int count = 0;
-        for (JobNode* job = head; job != nullptr; job = job->next)
-            jobArray[count++] = job;
-        
-        // Selection Sort by totalMatches (descending), then by totalScore (descending)
-        for (int i = 0; i < count - 1; i++) {
-            int maxIdx = i;
-            for (int j = i + 1; j < count; j++) {
-                // Primary: more matches wins
-                if (jobArray[j]->totalMatches > jobArray[maxIdx]->totalMatches) {
-                    maxIdx = j;
-                }
-                // Tiebreaker: if same matches, higher total score wins
-                else if (jobArray[j]->totalMatches == jobArray[maxIdx]->totalMatches &&
-                        jobArray[j]->totalScore > jobArray[maxIdx]->totalScore) {
-                    maxIdx = j;
-                }
-            }
-            if (maxIdx != i) {
-                JobNode* temp = jobArray[i];
-                jobArray[i] = jobArray[maxIdx];
-                jobArray[maxIdx] = temp;
-            }
-        }
-        
+
+        // By totalMatches (descending), then by totalScore (descending)
+        vector<JobNode*> top = getRankedJobs(RANK_BY_TOTAL_MATCHES, 0, 10);
         cout << "\nTop 10 Jobs by Total Matches (with Total Score)\n";
         cout << "------------------------------------------------------------\n";
-        int limit = (count < 10) ? count : 10;
-        for (int i = 0; i < limit; i++) {
-            cout << i + 1 << ". " << jobArray[i]->id
-                << " | Matches: " << jobArray[i]->totalMatches
-                << " | Total Score: " << jobArray[i]->totalScore
-                << " | Avg Score: " << jobArray[i]->averageScore << "\n";
+        for (size_t i = 0; i < top.size(); ++i) {
+            cout << i + 1 << ". " << top[i]->id
+                << " | Matches: " << top[i]->totalMatches
+                << " | Total Score: " << top[i]->totalScore
+                << " | Avg Score: " << top[i]->averageScore << "\n";
         }
         cout << "------------------------------------------------------------\n";
-        
-        delete[] jobArray;
     }
 
     size_t getTotalMemoryUsage() const {
@@ -238,35 +470,164 @@ public:
 
             // Add dynamic string buffers (approximate). capacity() is in chars (1 byte each).
             totalMemory += current->id.capacity();
-            totalMemory += current->description.capacity();
 
             current = current->next;
         }
 
-        // Add the linked-list object overhead once
+        // Add the linked-list object overhead once, plus its column mirror
         totalMemory += sizeof(*this);
+        totalMemory += unmatched.capacity() * sizeof(JobNode*);
+        totalMemory += columns.getMemoryUsage();
+        totalMemory += idIndex.getMemoryUsage();
+        totalMemory += text.getMemoryUsage();   // descriptions
 
         return totalMemory;
     }
 };
 
+// How a resume's last matching run ended
+enum MatchOutcome {
+    MATCH_PENDING,          // no matching run yet
+    MATCH_FOUND,
+    MATCH_NONE,             // no job to match against
+    MATCH_BELOW_THRESHOLD   // weighted strict mode rejected the best job
+};
+
 class ResumeNode {
 public:
     string id;
-    string description;
-    int skills[33];
-    int criticalSkills[6];
-    int coreSkills[10];
-    int softSkills[7];
+    string_view description;   // points into the owning list's TextArena
+    SkillMask skillMask;
+    SkillMask criticalMask;
+    SkillMask coreMask;
+    SkillMask softMask;
     ResumeNode* next;
+    int columnIndex;   // position in ResumeColumns
+    bool skillsExtracted;
 
-    string bestJobId;
-    string bestJobDesc;
+    // The best match is kept as a reference; its ID and text are looked up on display
+    const JobNode* bestJob;   // nullptr unless matchOutcome is MATCH_FOUND
+    MatchOutcome matchOutcome;
     double bestMatchScore;
 
-    ResumeNode(const string& rid, const string& desc, const string& skills)
-        : id(rid), description(desc), next(nullptr),
-          bestJobId(""), bestJobDesc(""), bestMatchScore(0) {}
+    ResumeNode(const string& rid, string_view desc)
+        : id(rid), description(desc), skillMask(0),
+          criticalMask(0), coreMask(0), softMask(0), next(nullptr), columnIndex(-1),
+          skillsExtracted(false), bestJob(nullptr), matchOutcome(MATCH_PENDING), bestMatchScore(0) {}
+
+    void setBestMatch(const JobNode* job, double score) {
+        bestJob = job;
+        matchOutcome = MATCH_FOUND;
+        bestMatchScore = score;
+    }
+
+    void clearBestMatch(MatchOutcome outcome) {
+        bestJob = nullptr;
+        matchOutcome = outcome;
+        bestMatchScore = 0;
+    }
+
+    string getBestJobId() const {
+        if (bestJob != nullptr) return bestJob->id;
+        return (matchOutcome == MATCH_PENDING) ? "" : "N/A";
+    }
+
+    string_view getBestJobDescription() const {
+        if (bestJob != nullptr) return bestJob->description;
+        if (matchOutcome == MATCH_BELOW_THRESHOLD) return "No suitable match";
+        return (matchOutcome == MATCH_PENDING) ? "" : "N/A";
+    }
+};
+
+// Struct-of-arrays mirror of a resume list, in list order, holding the
+// skill vectors read by the matching loops and the per-resume results.
+class ResumeColumns {
+public:
+    vector<ResumeNode*> nodes;
+    vector<int> ids;
+    vector<SkillMask> skillMask;
+    vector<SkillMask> criticalMask;
+    vector<SkillMask> coreMask;
+    vector<SkillMask> softMask;
+    vector<int> bestJob;         // column index into JobColumns, -1 when unmatched
+    vector<double> bestScore;
+
+    // Top-K recommendations: topK slots per resume, best first, -1 marks an unused slot
+    int topK = 1;
+    vector<int> topJobs;
+    vector<float> topScores;
+
+    int size() const { return (int)nodes.size(); }
+    ResumeNode* node(int index) const { return nodes[index]; }
+
+    vector<ResumeNode*>::const_iterator begin() const { return nodes.begin(); }
+    vector<ResumeNode*>::const_iterator end() const { return nodes.end(); }
+
+    void clear() {
+        nodes.clear(); ids.clear();
+        skillMask.clear(); criticalMask.clear(); coreMask.clear(); softMask.clear();
+        bestJob.clear(); bestScore.clear();
+        topJobs.clear(); topScores.clear();
+    }
+
+    void append(ResumeNode* resume) {
+        resume->columnIndex = size();
+        nodes.push_back(resume);
+        ids.push_back(idNumber(resume->id));
+        skillMask.push_back(resume->skillMask);
+        criticalMask.push_back(resume->criticalMask);
+        coreMask.push_back(resume->coreMask);
+        softMask.push_back(resume->softMask);
+        bestJob.push_back(-1);
+        bestScore.push_back(resume->bestMatchScore);
+        topJobs.insert(topJobs.end(), topK, -1);
+        topScores.insert(topScores.end(), topK, 0.0f);
+    }
+
+    void resetTopMatches(int k) {
+        topK = k < 1 ? 1 : k;
+        topJobs.assign((size_t)size() * topK, -1);
+        topScores.assign((size_t)size() * topK, 0.0f);
+    }
+
+    int topJob(int index, int rank) const { return topJobs[(size_t)index * topK + rank]; }
+    float topScore(int index, int rank) const { return topScores[(size_t)index * topK + rank]; }
+
+    // Stores a resume's ranked matches, clearing any slots past `count`
+    void setTopMatches(int index, const int* jobs, const double* scores, int count) {
+        size_t base = (size_t)index * topK;
+        for (int i = 0; i < topK; ++i) {
+            topJobs[base + i] = (i < count) ? jobs[i] : -1;
+            topScores[base + i] = (i < count) ? (float)scores[i] : 0.0f;
+        }
+    }
+
+    // Job indices of the stored results move when jobs are inserted at the front
+    void shiftJobIndices(int shift) {
+        if (shift == 0) return;
+        for (int& job : bestJob) if (job >= 0) job += shift;
+        for (int& job : topJobs) if (job >= 0) job += shift;
+    }
+
+    void rebuild(ResumeNode* head) {
+        clear();
+        for (ResumeNode* resume = head; resume != nullptr; resume = resume->next) append(resume);
+    }
+
+    void syncSkills(int index) {
+        const ResumeNode* resume = nodes[index];
+        skillMask[index] = resume->skillMask;
+        criticalMask[index] = resume->criticalMask;
+        coreMask[index] = resume->coreMask;
+        softMask[index] = resume->softMask;
+    }
+
+    size_t getMemoryUsage() const {
+        return nodes.capacity() * sizeof(ResumeNode*) + ids.capacity() * sizeof(int)
+             + (skillMask.capacity() + criticalMask.capacity() + coreMask.capacity() + softMask.capacity()) * sizeof(SkillMask)
+             + bestJob.capacity() * sizeof(int) + bestScore.capacity() * sizeof(double)
+             + topJobs.capacity() * sizeof(int) + topScores.capacity() * sizeof(float);
+    }
 };
 
 class ResumeLinkedList {
@@ -275,6 +636,11 @@ private:
     ResumeNode* tail;
     int size;
 
+    mutable ResumeColumns columns;
+    IdHashIndex<ResumeNode> idIndex;
+    TextArena text;
+    vector<ResumeNode*> unmatched;   // added since the last matching run
+
 public:
     ResumeLinkedList() : head(nullptr), tail(nullptr), size(0) {}
 
@@ -286,9 +652,9 @@ public:
         }
     }
 
-    void addResume(const string& id, const string& description) {
-        string skills = extract_skills(description);
-        ResumeNode* newNode = new ResumeNode(id, description, skills);
+    ResumeNode* addResume(const string& id, string_view description) {
+        description = text.intern(description);
+        ResumeNode* newNode = new ResumeNode(id, description);
         if (head == nullptr) {
             head = tail = newNode;
         } else {
@@ -296,25 +662,41 @@ public:
             tail = newNode;
         }
         size++;
+        idIndex.insert(idNumber(id), newNode, false);
+        columns.append(newNode);
+        unmatched.push_back(newNode);
+        return newNode;
     }
 
     int getSize() const { return size; }
     ResumeNode* getHead() const { return head; }
 
+    TextArena& getTextArena() { return text; }
+
+    // Resumes added since the last matching run, in list order; taking them resets the tracking
+    vector<ResumeNode*> takeUnmatchedResumes() {
+        vector<ResumeNode*> added;
+        added.swap(unmatched);
+        return added;
+    }
+
+    void markAllMatched() { unmatched.clear(); }
+
+    // Resumes are only ever appended, so the columns always match list order
+    ResumeColumns& getColumns() const { return columns; }
+
+    ResumeNode* getResumeAt(int index) const {
+        return (index >= 0 && index < columns.size()) ? columns.node(index) : nullptr;
+    }
+
     string getResumeId(int index) const {
-        ResumeNode* current = head;
-        for (int i = 0; i < index && current != nullptr; i++) {
-            current = current->next;
-        }
-        return (current != nullptr) ? current->id : "";
+        ResumeNode* resume = getResumeAt(index);
+        return (resume != nullptr) ? resume->id : "";
     }
 
     string getResumeDescription(int index) const {
-        ResumeNode* current = head;
-        for (int i = 0; i < index && current != nullptr; i++) {
-            current = current->next;
-        }
-        return (current != nullptr) ? current->description : "";
+        ResumeNode* resume = getResumeAt(index);
+        return (resume != nullptr) ? string(resume->description) : "";
     }
 
     void displayResumes() const {
@@ -333,18 +715,10 @@ public:
     ResumeNode* searchById(const string& searchId) const {
         if (searchId.empty()) return nullptr;
 
-        string digits;
-        for (char c : searchId) if (isdigit(static_cast<unsigned char>(c))) digits.push_back(c);
-
-        string needle;
-        if (!digits.empty()) {
-            int num = stoi(digits);
-            string numstr = to_string(num);
-            while (numstr.length() < 3) numstr = "0" + numstr;
-            needle = "R" + numstr;
-        } else {
-            needle = searchId;
-        }
+        string needle = normalizeSearchId(searchId, "R");
+        int key = idNumber(needle);
+        ResumeNode* hit = idIndex.find(key);
+        if (key >= 0 && (hit == nullptr || hit->id == needle)) return hit;
 
         for (ResumeNode* current = head; current != nullptr; current = current->next) {
             if (current->id == needle) return current;
@@ -359,106 +733,104 @@ public:
         while (current != nullptr) {
             totalMemory += sizeof(ResumeNode);
             totalMemory += current->id.capacity();
-            totalMemory += current->description.capacity();
             current = current->next;
         }
 
         totalMemory += sizeof(*this);
+        totalMemory += unmatched.capacity() * sizeof(ResumeNode*);
+        totalMemory += columns.getMemoryUsage();
+        totalMemory += idIndex.getMemoryUsage();
+        totalMemory += text.getMemoryUsage();   // descriptions
         return totalMemory;
     }
 };
 
 // Load Data Functions
-inline bool loadJobsFromCSV(const string& filename, JobLinkedList& jobs) {
-    ifstream file(filename);
+
+// Sequential ID with at least three digits ("J007", "J1234")
+inline string makeRecordId(char prefix, int counter) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%c%03d", prefix, counter);
+    return string(buffer);
+}
+
+// The file is mapped into the list's TextArena and every description is a
+// view into that mapping, so loading allocates nothing per record beyond the
+// node. Every record is one whole description (see parseCsvRecord), parsed on
+// `threadCount` threads (0 = all cores); IDs are handed out afterwards in file
+// order.
+inline bool loadJobsFromCSV(const string& filename, JobLinkedList& jobs, int threadCount = 0) {
+    ScopedPhase phase("load.jobs");
+    MappedFile* file = jobs.getTextArena().mapFile(filename);
     
-    if (!file.is_open()) {
+    if (file == nullptr) {
         cerr << "Error: Could not open " << filename << endl;
         return false;
     }
     
-    string line;
-    getline(file, line);
+    vector<string_view> records = parseCsvRecords(file->data(), file->size(), threadCount);
     
     int jobCounter = 1;
     int count = 0;
     
     cout << "\n--- Loading Jobs ---\n";
     
-    while (getline(file, line)) {
-        string trimmedLine = trim(line);
+    for (string_view record : records) {
+        string_view trimmedLine = trim(record);
         if (trimmedLine.empty()) continue;
 
-        string skills = extract_skills(trimmedLine);
-        if (skills.empty()) {
+        if (extract_skills(trimmedLine).empty()) {
             cout << "  Warning: No skills found in job description. Skipping line.\n";
             continue;
         }
 
-        // Generate ID
-        string generatedID = "J";
-        if (jobCounter < 10) generatedID += "00";
-        else if (jobCounter < 100) generatedID += "0";
-        generatedID += to_string(jobCounter);
-        
-        jobs.addJobAtEnd(generatedID, trimmedLine);
+        jobs.addJobAtEnd(makeRecordId('J', jobCounter), trimmedLine);
 
         count++;
         jobCounter++;
     }
     
-    file.close();
-    
     cout << "Successfully loaded " << count << " jobs\n";
     cout << "-------------------\n";
     
     return count > 0;
 }
 
-inline bool loadResumesFromCSV(const string& filename, ResumeLinkedList& resumes) {
-    ifstream file(filename);
+inline bool loadResumesFromCSV(const string& filename, ResumeLinkedList& resumes, int threadCount = 0) {
+    ScopedPhase phase("load.resumes");
+    MappedFile* file = resumes.getTextArena().mapFile(filename);
     
-    if (!file.is_open()) {
+    if (file == nullptr) {
         cerr << "Error: Could not open " << filename << endl;
         return false;
     }
     
-    string line;
-    getline(file, line);
+    vector<string_view> records = parseCsvRecords(file->data(), file->size(), threadCount);
     
     int resumeCounter = 1;
     int count = 0;
     
     cout << "\n--- Loading Resumes ---\n";
     
-    while (getline(file, line)) {
-        string trimmedLine = trim(line);
+    for (string_view record : records) {
+        string_view trimmedLine = trim(record);
         if (trimmedLine.empty()) continue;
 
-        string skills = extract_skills(trimmedLine);
-        if (skills.empty()) {
+        if (extract_skills(trimmedLine).empty()) {
             cout << "  Warning: No skills found in resume description. Skipping line.\n";
             continue;
         }
 
-        // Generate ID
-        string generatedID = "R";
-        if (resumeCounter < 10) generatedID += "00";
-        else if (resumeCounter < 100) generatedID += "0";
-        generatedID += to_string(resumeCounter);
-        
-        resumes.addResume(generatedID, trimmedLine);
+        resumes.addResume(makeRecordId('R', resumeCounter), trimmedLine);
         
         count++;
         resumeCounter++;
     }
     
-    file.close();
-    
     cout << "Successfully loaded " << count << " resumes\n";
     cout << "-------------------\n";
     
     return count > 0;
 }
 
-#endif
\ No newline at end of file
+#endif
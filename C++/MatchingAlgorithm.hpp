@@ -2,259 +2,689 @@
 #define MATCHING_ALGORITHM_HPP
 
 #include <iostream>
-#include <ctime>
-#include <cstring> // for memset, strstr
 #include <cmath>   // for pow
+#include <vector>
+#include "SkillVector.hpp"
+#include "SkillMatcher.hpp"
+#include "SkillTaxonomy.hpp"
+#include "ThreadPool.hpp"
+#include "InvertedIndex.hpp"
+#include "SignatureTable.hpp"
+#include "TopK.hpp"
 #include "LinkedListNodes.hpp"
+#include "Metrics.hpp"
 using namespace std;
 
 
-class KeywordAlgorithm {
-private:
-    static const int SKILL_COUNT = 33;
-    const char* skills[SKILL_COUNT] = {
-        "python", "java", "javascript", "c++", "sql", "excel", "power bi", "tableau",
-        "pandas", "machine learning", "deep learning", "nlp", "statistics", "data cleaning",
-        "reporting", "tensorflow", "keras", "mlops", "computer vision", "spring boot",
-        "rest apis", "docker", "git", "system design", "agile", "data analyst",
-        "data scientist", "software engineer", "ml engineer", "developer",
-        "engineer", "experience", "professional"};
-
-    inline void toLowerInPlace(string& s) {
-        for (size_t i = 0; i < s.size(); ++i)
-            s[i] = tolower(s[i]);
+// Fills every skill vector of a node from one pass over its description
+template <typename Node>
+inline void applySkillHits(Node* node, const SkillHits& hits) {
+    node->skillMask = hits.keyword;
+    node->criticalMask = hits.critical;
+    node->coreMask = hits.core;
+    node->softMask = hits.soft;
+}
+
+// Scans a node's description once; later calls are no-ops. Both match modes
+// ignore case themselves, so the description is left as it was loaded.
+template <typename Node>
+inline bool extractSkills(Node* node, const CompiledTaxonomy& taxonomy) {
+    if (node->skillsExtracted) return false;
+    addMetric(METRIC_BYTES_SCANNED, node->description.size());
+    applySkillHits(node, taxonomy.scan(node->description));
+    node->skillsExtracted = true;
+    return true;
+}
+
+// Nodes whose skills were already extracted, by an earlier run or from a
+// snapshot, are skipped: their masks are current
+inline void preprocessResumeSkills(ResumeLinkedList& resumes) {
+    ScopedPhase phase("preprocess.resumes");
+    const CompiledTaxonomy& taxonomy = activeTaxonomy();
+    ResumeColumns& cols = resumes.getColumns();
+    for (int i = 0; i < cols.size(); ++i)
+        if (extractSkills(cols.node(i), taxonomy)) cols.syncSkills(i);
+}
+
+inline void preprocessJobSkills(JobLinkedList& jobs) {
+    ScopedPhase phase("preprocess.jobs");
+    const CompiledTaxonomy& taxonomy = activeTaxonomy();
+    JobColumns& cols = jobs.getColumns();
+    for (int i = 0; i < cols.size(); ++i)
+        if (extractSkills(cols.node(i), taxonomy)) cols.syncSkills(i);
+}
+
+inline void addToJobStats(JobColumns& jobCols, const ResumeColumns& resumeCols, int r) {
+    int job = resumeCols.bestJob[r];
+    if (job < 0) return;
+    jobCols.totalMatches[job]++;
+    jobCols.totalScore[job] += resumeCols.bestScore[r];
+    jobCols.markStatsChanged(job);
+}
+
+inline void removeFromJobStats(JobColumns& jobCols, const ResumeColumns& resumeCols, int r) {
+    int job = resumeCols.bestJob[r];
+    if (job < 0) return;
+    jobCols.totalMatches[job]--;
+    jobCols.totalScore[job] -= resumeCols.bestScore[r];
+    jobCols.markStatsChanged(job);
+}
+
+// Offers a newly added job to resume r's stored ranking (best first, equal
+// scores by lower column index) and returns true if it was taken. Stored
+// scores are rounded to float, so scoreOf(job) recomputes the exact score of
+// an entry it is compared with.
+template <typename ScoreOf>
+inline bool offerRankedJob(ResumeColumns& cols, int r, int job, double score, ScoreOf scoreOf) {
+    const int k = cols.topK;
+    int* jobs = &cols.topJobs[(size_t)r * k];
+    float* scores = &cols.topScores[(size_t)r * k];
+    int count = 0;
+    while (count < k && jobs[count] >= 0) count++;
+
+    int pos = count;
+    while (pos > 0) {
+        double other = scoreOf(jobs[pos - 1]);
+        if (score > other || (score == other && job < jobs[pos - 1])) pos--;
+        else break;
     }
+    if (pos >= k) return false;
 
-    inline int containsWord(const string& text, const char* word) {
-        return strstr(text.c_str(), word) != nullptr;
+    for (int i = (count < k ? count : k - 1); i > pos; --i) {
+        jobs[i] = jobs[i - 1];
+        scores[i] = scores[i - 1];
+    }
+    jobs[pos] = job;
+    scores[pos] = (float)score;
+    return true;
+}
+
+// Adds each resume's best match to its job's totals, in resume order. Used for
+// serial runs.
+inline void accumulateJobStats(JobColumns& jobCols, const ResumeColumns& resumeCols) {
+    for (int r = 0; r < resumeCols.size(); ++r) addToJobStats(jobCols, resumeCols, r);
+}
+
+// Totals per job from each resume's matched job index, in one pass over the
+// resumes instead of comparing every resume's best job ID with every job.
+// In parallel, each chunk of resumes counts its matches per job; the per-chunk
+// counts are reduced into offsets that bucket the resumes by job, still in
+// resume order, so each job's score sum is added up in exactly the serial order
+// and the totals are bit-identical for any thread count.
+inline void calculateJobStats(JobColumns& jobCols, const ResumeColumns& resumeCols, int threadCount) {
+    ScopedPhase phase("aggregate");
+    const int jobCount = jobCols.size();
+    const int resumeCount = resumeCols.size();
+    const int* bestJob = resumeCols.bestJob.data();
+    const double* bestScore = resumeCols.bestScore.data();
+    WorkStealingPool pool(threadCount);
+    int chunks = pool.getThreadCount();
+    if (chunks > resumeCount / 1024) chunks = resumeCount / 1024;
+
+    jobCols.resetStats();
+    if (chunks <= 1) {
+        accumulateJobStats(jobCols, resumeCols);
+        jobCols.flushStats();
+        return;
     }
 
-    void preprocessResumeSkills(ResumeLinkedList& resumes) {
-        for (ResumeNode* r = resumes.getHead(); r != nullptr; r = r->next) {
-            toLowerInPlace(r->description);
-            for (int i = 0; i < SKILL_COUNT; ++i)
-                r->skills[i] = containsWord(r->description, skills[i]);
+    // Per-chunk match counts for every job
+    const int grain = (resumeCount + chunks - 1) / chunks;
+    vector<vector<int>> partial(chunks, vector<int>(jobCount, 0));
+    pool.parallelFor(resumeCount, grain, [&](int begin, int end, int) {
+        int* counts = partial[begin / grain].data();
+        for (int r = begin; r < end; ++r)
+            if (bestJob[r] >= 0) counts[bestJob[r]]++;
+    });
+
+    // Reduce the counts; each chunk's count becomes its write offset into the job's bucket
+    vector<int> bucketStart(jobCount + 1, 0);
+    for (int j = 0; j < jobCount; ++j) {
+        int offset = bucketStart[j];
+        for (int c = 0; c < chunks; ++c) {
+            int count = partial[c][j];
+            partial[c][j] = offset;
+            offset += count;
         }
+        jobCols.totalMatches[j] = offset - bucketStart[j];
+        bucketStart[j + 1] = offset;
     }
 
-    void preprocessJobSkills(JobLinkedList& jobs) {
-        for (JobNode* j = jobs.getHead(); j != nullptr; j = j->next) {
-            toLowerInPlace(j->description);
-            for (int i = 0; i < SKILL_COUNT; ++i)
-                j->skills[i] = containsWord(j->description, skills[i]);
+    vector<int> byJob(bucketStart[jobCount]);
+    pool.parallelFor(resumeCount, grain, [&](int begin, int end, int) {
+        int* cursor = partial[begin / grain].data();
+        for (int r = begin; r < end; ++r)
+            if (bestJob[r] >= 0) byJob[cursor[bestJob[r]]++] = r;
+    });
+
+    pool.parallelFor(jobCount, 1024, [&](int begin, int end, int) {
+        for (int j = begin; j < end; ++j) {
+            double total = 0.0;
+            for (int i = bucketStart[j]; i < bucketStart[j + 1]; ++i) total += bestScore[byJob[i]];
+            jobCols.totalScore[j] = total;
         }
-    }
+    });
+
+    jobCols.flushStats();
+}
 
-    inline int SkillVectorMatch(const int* resumeSkills, const int* jobSkills) {
-        int score = 0;
-        for (int i = 0; i < SKILL_COUNT; ++i)
-            score += (resumeSkills[i] & jobSkills[i]);
-        return score;
+class KeywordAlgorithm {
+private:
+    // Number of jobs scored per kernel call; keeps the score buffer in L1.
+    static const int SCORE_BLOCK = 512;
+    // Resumes handed to a worker at a time
+    static const int RESUME_GRAIN = 64;
+
+    int threadCount = 1;
+    int topK = 1;
+    bool useIndex = true;
+    bool useSignatures = true;
+    InvertedSkillIndex index;
+    SignatureGroups jobGroups;      // distinct job masks; searched instead of the full list
+    SignatureGroups resumeGroups;   // distinct resume masks; each one is scored once
+    const JobColumns* preparedJobs = nullptr;   // what jobGroups and the index were built from
+    unsigned long preparedLayout = 0;
+
+    inline int SkillVectorMatch(SkillMask resumeSkills, SkillMask jobSkills) {
+        return popcount64(resumeSkills & jobSkills);
     }
 
-    void calculateJobStats(JobLinkedList& jobs, const ResumeLinkedList& resumes) {
-        for (JobNode* job = jobs.getHead(); job != nullptr; job = job->next) {
-            int totalMatches = 0;
-            double totalScore = 0.0;
-            for (ResumeNode* res = resumes.getHead(); res != nullptr; res = res->next) {
-                if (res->bestJobId == job->id) {
-                    totalMatches++;
-                    totalScore += res->bestMatchScore;
-                }
+    // Per-worker search state, reused across resumes
+    struct Workspace {
+        IndexScratch scratch;
+        TopKHeap<int> heap;
+    };
+
+    // Full scan over the job groups in order. Their masks are contiguous, so the
+    // kernel scores whole blocks at once; the heap only sees jobs that beat its
+    // current K-th entry, so K > 1 costs little more than K = 1.
+    void scanAllJobs(SkillMask resumeMask, TopKHeap<int>& heap) {
+        const int jobCount = jobGroups.size();
+        const SkillMask* jobMasks = jobGroups.signatures.data();
+        int blockScores[SCORE_BLOCK];
+
+        for (int base = 0; base < jobCount; base += SCORE_BLOCK) {
+            int count = jobCount - base;
+            if (count > SCORE_BLOCK) count = SCORE_BLOCK;
+            scoreBlock(resumeMask, jobMasks + base, blockScores, count);
+            // Strict '>' keeps the first job with the highest score
+            for (int i = 0; i < count; ++i) {
+                if (!heap.full() || blockScores[i] > heap.worst().score)
+                    heap.push(blockScores[i], base + i);
             }
-            job->totalMatches = totalMatches;
-            job->totalScore = totalScore;
-            job->averageScore = (totalMatches > 0) ? (totalScore / totalMatches) : 0.0;
         }
     }
 
+    // Ranked job column indices for a resume mask, best first; returns how many.
+    // Groups are in first-appearance order, so the first winning group's
+    // representative is the first winning job of the whole list.
+    int findTopJobs(SkillMask resumeMask, Workspace& ws, int* outJobs, double* outScores) {
+        ws.heap.reset(topK);
+        if (useIndex) {
+            index.topKeywordJobs(resumeMask, ws.scratch, ws.heap);
+        } else {
+            scanAllJobs(resumeMask, ws.heap);
+            ws.scratch.scored += jobGroups.size();
+        }
+
+        const auto& ranked = ws.heap.sorted();
+        if (ranked.empty()) return 0;
+        if (topK == 1) {
+            outJobs[0] = jobGroups.representative[ranked[0].index];
+            outScores[0] = ranked[0].score;
+            return 1;
+        }
+        return expandTopGroups<int>(ranked, jobGroups, topK, outJobs, outScores);
+    }
+
+    void publishMatch(ResumeColumns& resumeCols, int r, const JobColumns& jobCols, int bestJob, int maxScore) {
+        ResumeNode* resume = resumeCols.node(r);
+        if (bestJob >= 0) {
+            resume->setBestMatch(jobCols.node(bestJob), maxScore);
+        } else {
+            resume->clearBestMatch(MATCH_NONE);
+        }
+        resumeCols.bestJob[r] = bestJob;
+        resumeCols.bestScore[r] = resume->bestMatchScore;
+    }
+
 public:
-    void performMatching(ResumeLinkedList& resumes, JobLinkedList& jobs) {
-        clock_t start = clock();
+    // 1 runs serially, 0 uses every hardware thread
+    void setThreadCount(int threads) { threadCount = threads; }
+    int getThreadCount() const { return threadCount; }
 
-        // --- STEP 1: Preprocess text into skill vectors ---
-        preprocessResumeSkills(resumes);
+    // Search through the inverted skill index (default) or scan every job
+    void setUseIndex(bool enabled) { useIndex = enabled; }
+    bool getUseIndex() const { return useIndex; }
+
+    // Score each distinct skill signature once (default) or every node separately
+    void setUseSignatures(bool enabled) { useSignatures = enabled; }
+    bool getUseSignatures() const { return useSignatures; }
+
+    // Number of ranked recommendations kept per resume (1 = best match only)
+    void setTopK(int k) { topK = k < 1 ? 1 : k; }
+    int getTopK() const { return topK; }
+
+    // Extracts job skills and builds the job-side search structures
+    void prepareJobs(JobLinkedList& jobs) {
+        ScopedPhase phase("prepare.keyword");
         preprocessJobSkills(jobs);
+        JobColumns& jobCols = jobs.getColumns();
+        if (useSignatures) jobGroups.build(jobCols.skillMask.data(), jobCols.size());
+        else jobGroups.buildIdentity(jobCols.skillMask.data(), jobCols.size());
+        if (useIndex) index.buildKeyword(jobGroups.signatures.data(), jobGroups.size());
+        preparedJobs = &jobCols;
+        preparedLayout = jobCols.layoutVersion;
+    }
 
-        // --- STEP 2: Main matching loop ---
-        for (ResumeNode* resume = resumes.getHead(); resume != nullptr; resume = resume->next) {
-            int maxScore = -1;
-            JobNode* bestJob = nullptr;
-
-            for (JobNode* job = jobs.getHead(); job != nullptr; job = job->next) {
-                int score = SkillVectorMatch(resume->skills, job->skills);
-                if (score > maxScore) {
-                    maxScore = score;
-                    bestJob = job;
-                }
+    // Matches every resume in the list against the jobs given to prepareJobs;
+    // job stats are left to the caller
+    void matchResumes(ResumeLinkedList& resumes, const JobColumns& jobCols) {
+        ScopedPhase phase("match.keyword");
+        preprocessResumeSkills(resumes);
+        ResumeColumns& resumeCols = resumes.getColumns();
+        if (useSignatures) resumeGroups.build(resumeCols.skillMask.data(), resumeCols.size());
+        else resumeGroups.buildIdentity(resumeCols.skillMask.data(), resumeCols.size());
+
+        // Main matching loop over distinct resumes, split across the pool.
+        // Every group writes only its own slots, so any split gives the serial result.
+        WorkStealingPool pool(threadCount);
+        vector<Workspace> workspaces(pool.getThreadCount());
+        for (Workspace& ws : workspaces) ws.scratch.prepare(jobGroups.size());
+        const int groupCount = resumeGroups.size();
+        vector<int> groupTopJobs((size_t)groupCount * topK);
+        vector<double> groupTopScores((size_t)groupCount * topK);
+        vector<int> groupTopCount(groupCount);
+        pool.parallelFor(groupCount, RESUME_GRAIN, [&](int begin, int end, int worker) {
+            for (int g = begin; g < end; ++g)
+                groupTopCount[g] = findTopJobs(resumeGroups.signatures[g], workspaces[worker],
+                                               &groupTopJobs[(size_t)g * topK], &groupTopScores[(size_t)g * topK]);
+        });
+        for (const Workspace& ws : workspaces) addMetric(METRIC_PAIR_COMPARISONS, ws.scratch.scored);
+
+        // Fan each group's result back out to its resumes
+        resumeCols.resetTopMatches(topK);
+        pool.parallelFor(resumeCols.size(), RESUME_GRAIN, [&](int begin, int end, int) {
+            for (int r = begin; r < end; ++r) {
+                int g = resumeGroups.groupOf[r];
+                const int* top = &groupTopJobs[(size_t)g * topK];
+                const double* scores = &groupTopScores[(size_t)g * topK];
+                int count = groupTopCount[g];
+                publishMatch(resumeCols, r, jobCols, count > 0 ? top[0] : -1, count > 0 ? (int)scores[0] : 0);
+                resumeCols.setTopMatches(r, top, scores, count);
             }
+        });
+    }
 
-            if (bestJob) {
-                resume->bestJobDesc = bestJob->description;
-                resume->bestJobId = bestJob->id;
-                resume->bestMatchScore = maxScore;
-            } else {
-                resume->bestJobDesc = "N/A";
-                resume->bestJobId = "N/A";
-                resume->bestMatchScore = 0;
-            }
-        }
+    void performMatching(ResumeLinkedList& resumes, JobLinkedList& jobs) {
+        ScopedPhase phase("run.keyword");
+        Stopwatch watch;
+
+        // --- STEP 1: Preprocess text into skill vectors and index the jobs ---
+        prepareJobs(jobs);
+        jobs.markAllMatched();
+        resumes.markAllMatched();
+
+        // --- STEP 2: Match every resume ---
+        JobColumns& jobCols = jobs.getColumns();
+        matchResumes(resumes, jobCols);
 
         // --- STEP 3: Calculate aggregate job stats ---
-        calculateJobStats(jobs, resumes);
+        calculateJobStats(jobCols, resumes.getColumns(), threadCount);
 
-        double timeTaken = double(clock() - start) / CLOCKS_PER_SEC;
+        double timeTaken = watch.elapsed();
         cout << "Optimized Keyword Matching completed in " << timeTaken << " seconds.\n";
     }
+
+    // --- Incremental updates to the results of the last full run ---
+
+    // Scores only the resumes added since the last run. Their matches are added
+    // to the job stats in list order, so the totals equal a full run's.
+    void matchNewResumes(ResumeLinkedList& resumes, JobLinkedList& jobs) {
+        vector<ResumeNode*> added = resumes.takeUnmatchedResumes();
+        if (added.empty()) return;
+        ScopedPhase phase("incremental.resumes");
+        JobColumns& jobCols = jobs.getColumns();
+        ResumeColumns& resumeCols = resumes.getColumns();
+        if (resumeCols.topK != topK) {   // stored rankings have another length
+            performMatching(resumes, jobs);
+            return;
+        }
+        if (preparedJobs != &jobCols || preparedLayout != jobCols.layoutVersion) prepareJobs(jobs);
+
+        const CompiledTaxonomy& taxonomy = activeTaxonomy();
+        Workspace ws;
+        ws.scratch.prepare(jobGroups.size());
+        vector<int> top(topK);
+        vector<double> scores(topK);
+        for (ResumeNode* resume : added) {
+            const int r = resume->columnIndex;
+            if (extractSkills(resume, taxonomy)) resumeCols.syncSkills(r);
+            int count = findTopJobs(resumeCols.skillMask[r], ws, top.data(), scores.data());
+            publishMatch(resumeCols, r, jobCols, count > 0 ? top[0] : -1, count > 0 ? (int)scores[0] : 0);
+            resumeCols.setTopMatches(r, top.data(), scores.data(), count);
+            addToJobStats(jobCols, resumeCols, r);
+        }
+        addMetric(METRIC_PAIR_COMPARISONS, ws.scratch.scored);
+        jobCols.flushChangedStats();
+    }
+
+    // Compares only the jobs added since the last run with each resume's stored
+    // ranking; a resume whose best job changes moves its share of the job stats.
+    void matchNewJobs(ResumeLinkedList& resumes, JobLinkedList& jobs) {
+        int shift;
+        vector<JobNode*> added = jobs.takeUnmatchedJobs(shift);
+        if (added.empty()) return;
+        ScopedPhase phase("incremental.jobs");
+        const CompiledTaxonomy& taxonomy = activeTaxonomy();
+        for (JobNode* job : added) extractSkills(job, taxonomy);
+        JobColumns& jobCols = jobs.getColumns();
+        for (JobNode* job : added) jobCols.syncSkills(job->columnIndex);
+        ResumeColumns& resumeCols = resumes.getColumns();
+        resumeCols.shiftJobIndices(shift);
+        uint64_t pairs = 0;
+
+        for (int r = 0; r < resumeCols.size(); ++r) {
+            if (resumeCols.node(r)->matchOutcome == MATCH_PENDING) continue;   // for matchNewResumes
+            pairs += added.size();
+            const SkillMask mask = resumeCols.skillMask[r];
+            auto scoreOf = [&](int j) { return (double)SkillVectorMatch(mask, jobCols.skillMask[j]); };
+            for (JobNode* job : added)
+                offerRankedJob(resumeCols, r, job->columnIndex, scoreOf(job->columnIndex), scoreOf);
+
+            const int best = resumeCols.topJob(r, 0);
+            if (best == resumeCols.bestJob[r]) continue;
+            removeFromJobStats(jobCols, resumeCols, r);
+            publishMatch(resumeCols, r, jobCols, best, (int)scoreOf(best));
+            addToJobStats(jobCols, resumeCols, r);
+        }
+        addMetric(METRIC_PAIR_COMPARISONS, pairs);
+        jobCols.flushChangedStats();
+    }
 };
 
 class WeightedAlgorithm {
 private:
     bool strictMode = true;
     double strictThreshold = 4.0;
-    static const int CRITICAL_COUNT = 6;
-    static const int CORE_COUNT = 10;
-    static const int SOFT_COUNT = 7;
-
-    const char* CriticalSkills[CRITICAL_COUNT] = {
-        "machine learning", "deep learning", "computer vision", "mlops", "tensorflow", "keras"
-    };
-    const char* CoreSkills[CORE_COUNT] = {
-        "python", "java", "sql", "nlp", "spring boot", "docker", "system design", "rest apis", "javascript", "c++"
-    };
-    const char* SoftSkills[SOFT_COUNT] = {
-        "pandas", "excel", "power bi", "tableau", "git", "agile", "statistics"
-    };
-
-
-    inline void toLowerInPlace(string& s) {
-        for (size_t i = 0; i < s.size(); ++i)
-            s[i] = tolower(s[i]);
+    static const int RESUME_GRAIN = 64;
+
+    int threadCount = 1;
+    int topK = 1;
+    bool useIndex = true;
+    bool useSignatures = true;
+    InvertedSkillIndex index;
+    TierLayout tiers = activeTaxonomy().getTierLayout();
+    SignatureGroups jobGroups;      // keyed on tiers.pack() of the three tier masks
+    SignatureGroups resumeGroups;
+    const JobColumns* preparedJobs = nullptr;   // what jobGroups and the index were built from
+    unsigned long preparedLayout = 0;
+    vector<SkillMask> jobTiers;
+    vector<SkillMask> resumeTiers;
+    vector<int> jobPossible;        // tiers.weight() of each job group's signature
+
+    // Number of jobs scored per kernel call; keeps the score buffer in L1
+    static const int SCORE_BLOCK = 512;
+
+    // Score of job j for resume r as the exact fraction matched / jobPossible,
+    // both in integer points of the taxonomy's tier weights; r and j are tiers.pack() masks
+    WeightedScore weightedFraction(SkillMask r, SkillMask j) const {
+        const int jobPossible = tiers.weight(j);
+        if (jobPossible < tiers.minJobPoints) return WeightedScore();
+        return WeightedScore(tiers.weight(r & j), jobPossible);
     }
 
-    inline int containsWord(const string& text, const char* word) {
-        return strstr(text.c_str(), word) != nullptr;
+    // The displayed 0-10 score; same value as summing the weights in doubles
+    inline double WeightedSkillMatch(SkillMask r, SkillMask j) {
+        return weightedFraction(r, j).value();
     }
 
-    void preprocessResumeSkills(ResumeLinkedList& resumes) {
-        for (ResumeNode* r = resumes.getHead(); r != nullptr; r = r->next) {
-            toLowerInPlace(r->description);
+    struct Workspace {
+        IndexScratch scratch;
+        TopKHeap<WeightedScore> heap;   // exact fractions, compared by cross-multiplication
+    };
 
-            for (int i = 0; i < CRITICAL_COUNT; ++i)
-                r->criticalSkills[i] = containsWord(r->description, CriticalSkills[i]);
-            for (int i = 0; i < CORE_COUNT; ++i)
-                r->coreSkills[i] = containsWord(r->description, CoreSkills[i]);
-            for (int i = 0; i < SOFT_COUNT; ++i)
-                r->softSkills[i] = containsWord(r->description, SoftSkills[i]);
+    // Full scan over the job groups in order. The kernel computes the matched
+    // points of a whole block at once; each job's jobPossible was computed in
+    // prepareJobs, so no pair needs a division. Strict '>' keeps the first job
+    // with the highest score.
+    void scanAllJobs(SkillMask resumeMask, TopKHeap<WeightedScore>& heap) {
+        const int jobCount = jobGroups.size();
+        const SkillMask* jobMasks = jobGroups.signatures.data();
+        const int* possible = jobPossible.data();
+        int blockPoints[SCORE_BLOCK];
+
+        for (int base = 0; base < jobCount; base += SCORE_BLOCK) {
+            int count = jobCount - base;
+            if (count > SCORE_BLOCK) count = SCORE_BLOCK;
+            weightBlock(resumeMask, jobMasks + base, blockPoints, count, tiers.points);
+            for (int i = 0; i < count; ++i) {
+                const int den = possible[base + i];
+                const WeightedScore score = (den < tiers.minJobPoints) ? WeightedScore() : WeightedScore(blockPoints[i], den);
+                if (!heap.full() || heap.worst().score < score)
+                    heap.push(score, base + i);
+            }
         }
     }
 
-    void preprocessJobSkills(JobLinkedList& jobs) {
-        for (JobNode* j = jobs.getHead(); j != nullptr; j = j->next) {
-            toLowerInPlace(j->description);
-
-            for (int i = 0; i < CRITICAL_COUNT; ++i)
-                j->criticalSkills[i] = containsWord(j->description, CriticalSkills[i]);
-            for (int i = 0; i < CORE_COUNT; ++i)
-                j->coreSkills[i] = containsWord(j->description, CoreSkills[i]);
-            for (int i = 0; i < SOFT_COUNT; ++i)
-                j->softSkills[i] = containsWord(j->description, SoftSkills[i]);
+    template <typename Score>
+    int rankedToJobs(TopKHeap<Score>& heap, int* outJobs, double* outScores) {
+        const auto& ranked = heap.sorted();
+        if (ranked.empty()) return 0;
+        if (topK == 1) {
+            outJobs[0] = jobGroups.representative[ranked[0].index];
+            outScores[0] = scoreValue(ranked[0].score);
+            return 1;
         }
+        return expandTopGroups<Score>(ranked, jobGroups, topK, outJobs, outScores);
     }
 
-    inline double WeightedSkillMatch(const ResumeNode* r, const JobNode* j) {
-        double score = 0.0;
-        double jobPossible = 0.0;
-
-        for (int i = 0; i < CRITICAL_COUNT; ++i) {
-            if (j->criticalSkills[i]) {
-                jobPossible += 3;
-                if (r->criticalSkills[i]) score += 3;
-            }
+    int findTopJobs(SkillMask resumeMask, Workspace& ws, int* outJobs, double* outScores) {
+        ws.heap.reset(topK);
+        if (useIndex) {
+            index.topWeightedJobs(resumeMask, ws.scratch, ws.heap);
+        } else {
+            scanAllJobs(resumeMask, ws.heap);
+            ws.scratch.scored += jobGroups.size();
         }
+        return rankedToJobs(ws.heap, outJobs, outScores);
+    }
 
-        for (int i = 0; i < CORE_COUNT; ++i) {
-            if (j->coreSkills[i]) {
-                jobPossible += 2;
-                if (r->coreSkills[i]) score += 2;
+    void publishMatch(ResumeColumns& resumeCols, int r, const JobColumns& jobCols, int bestJob, double maxScore) {
+        ResumeNode* resume = resumeCols.node(r);
+        if (bestJob >= 0) {
+            if (strictMode && maxScore < strictThreshold) {
+                // Below threshold — treat as no valid match
+                resume->clearBestMatch(MATCH_BELOW_THRESHOLD);
+                bestJob = -1;
+            } else {
+                // Acceptable match
+                resume->setBestMatch(jobCols.node(bestJob), maxScore);
             }
+        } else {
+            resume->clearBestMatch(MATCH_NONE);
         }
+        resumeCols.bestJob[r] = bestJob;
+        resumeCols.bestScore[r] = resume->bestMatchScore;
+    }
 
-        for (int i = 0; i < SOFT_COUNT; ++i) {
-            if (j->softSkills[i]) {
-                jobPossible += 1;
-                if (r->softSkills[i]) score += 1;
-            }
-        }
+public:
+    // 1 runs serially, 0 uses every hardware thread
+    void setThreadCount(int threads) { threadCount = threads; }
+    int getThreadCount() const { return threadCount; }
 
-        if (jobPossible < 5.0) return 0.0;
-        
-        return (score / jobPossible) * 10.0;  // Simple linear scale
-    }
+    // Search through the inverted skill index (default) or scan every job
+    void setUseIndex(bool enabled) { useIndex = enabled; }
+    bool getUseIndex() const { return useIndex; }
 
-    void calculateJobStats(JobLinkedList& jobs, const ResumeLinkedList& resumes) {
-        for (JobNode* job = jobs.getHead(); job != nullptr; job = job->next) {
-            int totalMatches = 0;
-            double totalScore = 0.0;
+    // Score each distinct skill signature once (default) or every node separately
+    void setUseSignatures(bool enabled) { useSignatures = enabled; }
+    bool getUseSignatures() const { return useSignatures; }
 
-            for (ResumeNode* res = resumes.getHead(); res != nullptr; res = res->next) {
-                if (res->bestJobId == job->id) {
-                    totalMatches++;
-                    totalScore += res->bestMatchScore;
-                }
-            }
+    // Number of ranked recommendations kept per resume (1 = best match only)
+    void setTopK(int k) { topK = k < 1 ? 1 : k; }
+    int getTopK() const { return topK; }
 
-            job->totalMatches = totalMatches;
-            job->totalScore = totalScore;
-            job->averageScore = (totalMatches > 0) ? (totalScore / totalMatches) : 0.0;
-        }
+    // Extracts job skills and builds the job-side search structures
+    void prepareJobs(JobLinkedList& jobs) {
+        ScopedPhase phase("prepare.weighted");
+        preprocessJobSkills(jobs);
+        JobColumns& jobCols = jobs.getColumns();
+        jobTiers.resize(jobCols.size());
+        for (int j = 0; j < jobCols.size(); ++j)
+            jobTiers[j] = tiers.pack(jobCols.criticalMask[j], jobCols.coreMask[j], jobCols.softMask[j]);
+        if (useSignatures) jobGroups.build(jobTiers.data(), (int)jobTiers.size());
+        else jobGroups.buildIdentity(jobTiers.data(), (int)jobTiers.size());
+        jobPossible.resize(jobGroups.size());
+        for (int g = 0; g < jobGroups.size(); ++g) jobPossible[g] = tiers.weight(jobGroups.signatures[g]);
+        if (useIndex) index.buildWeighted(jobGroups.signatures.data(), jobGroups.size(), tiers);
+        preparedJobs = &jobCols;
+        preparedLayout = jobCols.layoutVersion;
+    }
+
+    // Matches every resume in the list against the jobs given to prepareJobs;
+    // job stats are left to the caller
+    void matchResumes(ResumeLinkedList& resumes, const JobColumns& jobCols) {
+        ScopedPhase phase("match.weighted");
+        preprocessResumeSkills(resumes);
+        ResumeColumns& resumeCols = resumes.getColumns();
+        resumeTiers.resize(resumeCols.size());
+        for (int r = 0; r < resumeCols.size(); ++r)
+            resumeTiers[r] = tiers.pack(resumeCols.criticalMask[r], resumeCols.coreMask[r], resumeCols.softMask[r]);
+        if (useSignatures) resumeGroups.build(resumeTiers.data(), (int)resumeTiers.size());
+        else resumeGroups.buildIdentity(resumeTiers.data(), (int)resumeTiers.size());
+
+        // Resume-to-job matching over distinct resumes, split across the pool
+        WorkStealingPool pool(threadCount);
+        vector<Workspace> workspaces(pool.getThreadCount());
+        for (Workspace& ws : workspaces) ws.scratch.prepare(jobGroups.size());
+        const int groupCount = resumeGroups.size();
+        vector<int> groupTopJobs((size_t)groupCount * topK);
+        vector<double> groupTopScores((size_t)groupCount * topK);
+        vector<int> groupTopCount(groupCount);
+        pool.parallelFor(groupCount, RESUME_GRAIN, [&](int begin, int end, int worker) {
+            for (int g = begin; g < end; ++g) {
+                int* top = &groupTopJobs[(size_t)g * topK];
+                double* scores = &groupTopScores[(size_t)g * topK];
+                int count = findTopJobs(resumeGroups.signatures[g], workspaces[worker], top, scores);
+                // Recommendations below the strict threshold are not suitable matches
+                if (strictMode)
+                    while (count > 1 && scores[count - 1] < strictThreshold) count--;
+                groupTopCount[g] = count;
+            }
+        });
+        for (const Workspace& ws : workspaces) addMetric(METRIC_PAIR_COMPARISONS, ws.scratch.scored);
+
+        resumeCols.resetTopMatches(topK);
+        pool.parallelFor(resumeCols.size(), RESUME_GRAIN, [&](int begin, int end, int) {
+            for (int r = begin; r < end; ++r) {
+                int g = resumeGroups.groupOf[r];
+                const int* top = &groupTopJobs[(size_t)g * topK];
+                const double* scores = &groupTopScores[(size_t)g * topK];
+                int count = groupTopCount[g];
+                publishMatch(resumeCols, r, jobCols, count > 0 ? top[0] : -1, count > 0 ? scores[0] : 0.0);
+                // publishMatch drops a best match below the threshold
+                if (resumeCols.bestJob[r] < 0) count = 0;
+                resumeCols.setTopMatches(r, top, scores, count);
+            }
+        });
     }
 
-public:
     void performWeightedMatching(ResumeLinkedList& resumes, JobLinkedList& jobs) {
-        clock_t start = clock();
+        ScopedPhase phase("run.weighted");
+        Stopwatch watch;
 
-        preprocessResumeSkills(resumes);
-        preprocessJobSkills(jobs);
+        // STEP 1: Preprocess and index the jobs
+        prepareJobs(jobs);
+        jobs.markAllMatched();
+        resumes.markAllMatched();
 
         // STEP 2: Resume-to-job matching
-        for (ResumeNode* resume = resumes.getHead(); resume != nullptr; resume = resume->next) {
-            double maxScore = -1.0;
-            JobNode* bestJob = nullptr;
-
-            for (JobNode* job = jobs.getHead(); job != nullptr; job = job->next) {
-                double score = WeightedSkillMatch(resume, job);
-                if (score > maxScore) {
-                    maxScore = score;
-                    bestJob = job;
-                }
-            }
+        JobColumns& jobCols = jobs.getColumns();
+        matchResumes(resumes, jobCols);
 
-                if (bestJob) {
-                    if (strictMode && maxScore < strictThreshold) {
-                        // Below threshold — treat as no valid match
-                        resume->bestJobDesc = "No suitable match";
-                        resume->bestJobId = "N/A";
-                        resume->bestMatchScore = 0;
-                    } else {
-                        // Acceptable match
-                        resume->bestJobDesc = bestJob->description;
-                        resume->bestJobId = bestJob->id;
-                        resume->bestMatchScore = maxScore;
-                    }
-                } else {
-                    resume->bestJobDesc = "N/A";
-                    resume->bestJobId = "N/A";
-                    resume->bestMatchScore = 0;
-                }
+        // STEP 3: Aggregate job stats
+        calculateJobStats(jobCols, resumes.getColumns(), threadCount);
 
+        double timeTaken = watch.elapsed();
+        cout << "Balanced Weighted Matching completed in " << timeTaken << " seconds.\n";
+    }
+
+    // --- Incremental updates to the results of the last full run ---
+
+    // Scores only the resumes added since the last run. Their matches are added
+    // to the job stats in list order, so the totals equal a full run's.
+    void matchNewResumes(ResumeLinkedList& resumes, JobLinkedList& jobs) {
+        vector<ResumeNode*> added = resumes.takeUnmatchedResumes();
+        if (added.empty()) return;
+        ScopedPhase phase("incremental.resumes");
+        JobColumns& jobCols = jobs.getColumns();
+        ResumeColumns& resumeCols = resumes.getColumns();
+        if (resumeCols.topK != topK) {   // stored rankings have another length
+            performWeightedMatching(resumes, jobs);
+            return;
         }
+        if (preparedJobs != &jobCols || preparedLayout != jobCols.layoutVersion) prepareJobs(jobs);
+
+        const CompiledTaxonomy& taxonomy = activeTaxonomy();
+        Workspace ws;
+        ws.scratch.prepare(jobGroups.size());
+        vector<int> top(topK);
+        vector<double> scores(topK);
+        for (ResumeNode* resume : added) {
+            const int r = resume->columnIndex;
+            if (extractSkills(resume, taxonomy)) resumeCols.syncSkills(r);
+            const SkillMask mask = tiers.pack(resumeCols.criticalMask[r], resumeCols.coreMask[r], resumeCols.softMask[r]);
+            int count = findTopJobs(mask, ws, top.data(), scores.data());
+            if (strictMode)
+                while (count > 1 && scores[count - 1] < strictThreshold) count--;
+            publishMatch(resumeCols, r, jobCols, count > 0 ? top[0] : -1, count > 0 ? scores[0] : 0.0);
+            if (resumeCols.bestJob[r] < 0) count = 0;
+            resumeCols.setTopMatches(r, top.data(), scores.data(), count);
+            addToJobStats(jobCols, resumeCols, r);
+        }
+        addMetric(METRIC_PAIR_COMPARISONS, ws.scratch.scored);
+        jobCols.flushChangedStats();
+    }
 
-        // STEP 3: Aggregate job stats
-        calculateJobStats(jobs, resumes);
+    // Compares only the jobs added since the last run with each resume's stored
+    // ranking; a resume whose best job changes moves its share of the job stats.
+    // Stats are adjusted by subtraction, so a moved fractional score can leave
+    // the totals a rounding step away from a full run's.
+    void matchNewJobs(ResumeLinkedList& resumes, JobLinkedList& jobs) {
+        int shift;
+        vector<JobNode*> added = jobs.takeUnmatchedJobs(shift);
+        if (added.empty()) return;
+        ScopedPhase phase("incremental.jobs");
+        const CompiledTaxonomy& taxonomy = activeTaxonomy();
+        for (JobNode* job : added) extractSkills(job, taxonomy);
+        JobColumns& jobCols = jobs.getColumns();
+        for (JobNode* job : added) jobCols.syncSkills(job->columnIndex);
+        ResumeColumns& resumeCols = resumes.getColumns();
+        resumeCols.shiftJobIndices(shift);
+        uint64_t pairs = 0;
+
+        auto tiersOf = [&](int j) { return tiers.pack(jobCols.criticalMask[j], jobCols.coreMask[j], jobCols.softMask[j]); };
+        for (int r = 0; r < resumeCols.size(); ++r) {
+            if (resumeCols.node(r)->matchOutcome == MATCH_PENDING) continue;   // for matchNewResumes
+            pairs += added.size();
+            const SkillMask mask = tiers.pack(resumeCols.criticalMask[r], resumeCols.coreMask[r], resumeCols.softMask[r]);
+            auto scoreOf = [&](int j) { return WeightedSkillMatch(mask, tiersOf(j)); };
+            for (JobNode* job : added) {
+                double score = scoreOf(job->columnIndex);
+                // Stored rankings only hold jobs that pass the strict threshold
+                if (strictMode && score < strictThreshold) continue;
+                offerRankedJob(resumeCols, r, job->columnIndex, score, scoreOf);
+            }
 
-        double timeTaken = double(clock() - start) / CLOCKS_PER_SEC;
-        cout << "Balanced Weighted Matching completed in " << timeTaken << " seconds.\n";
+            const int best = resumeCols.topJob(r, 0);
+            if (best < 0 || best == resumeCols.bestJob[r]) continue;
+            removeFromJobStats(jobCols, resumeCols, r);
+            publishMatch(resumeCols, r, jobCols, best, scoreOf(best));
+            addToJobStats(jobCols, resumeCols, r);
+        }
+        addMetric(METRIC_PAIR_COMPARISONS, pairs);
+        jobCols.flushChangedStats();
     }
 };
 
@@ -0,0 +1,226 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Lightweight run instrumentation: wall time per named phase on the
+// monotonic clock, plus counters for pair comparisons, bytes scanned by skill
+// extraction and heap allocations. Everything is off until enabled; a
+// disabled phase or counter costs one relaxed atomic load and no clock read.
+// Hot loops add up their counts locally and report them once per call.
+
+enum MetricCounter {
+    METRIC_PAIR_COMPARISONS = 0,   // resume-job scores actually computed
+    METRIC_BYTES_SCANNED,          // description bytes run through the skill matcher
+    METRIC_ALLOCATIONS,            // operator new calls (needs METRICS_ALLOCATION_HOOKS)
+    METRIC_ALLOCATED_BYTES,
+    METRIC_COUNTER_COUNT
+};
+
+static const char* const METRIC_COUNTER_NAMES[METRIC_COUNTER_COUNT] = {
+    "pair_comparisons", "bytes_scanned", "allocations", "allocated_bytes"
+};
+
+// Namespace-scope atomics are constant-initialized, so the allocation hooks
+// can use them before any other static exists
+inline atomic<bool> metricsEnabled{false};
+inline atomic<uint64_t> metricCounters[METRIC_COUNTER_COUNT];
+
+inline bool metricsActive() { return metricsEnabled.load(memory_order_relaxed); }
+
+inline void addMetric(MetricCounter counter, uint64_t amount) {
+    if (metricsActive()) metricCounters[counter].fetch_add(amount, memory_order_relaxed);
+}
+
+// Wall-clock seconds on the monotonic clock
+class Stopwatch {
+private:
+    chrono::steady_clock::time_point start;
+
+public:
+    Stopwatch() : start(chrono::steady_clock::now()) {}
+
+    double elapsed() const { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); }
+
+    // Seconds since construction or the previous lap
+    double lap() {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        double seconds = chrono::duration<double>(now - start).count();
+        start = now;
+        return seconds;
+    }
+};
+
+struct PhaseMetrics {
+    string name;
+    uint64_t calls = 0;
+    double seconds = 0.0;
+    uint64_t counters[METRIC_COUNTER_COUNT] = {};   // added while the phase ran, on any thread
+};
+
+// Totals per phase name, in the order the phases first ran. Phases nest, so
+// an outer phase's time and counters include those of the phases inside it.
+class MetricsRegistry {
+private:
+    mutable mutex lock;
+    vector<PhaseMetrics> phases;
+
+    MetricsRegistry() {}
+
+public:
+    static MetricsRegistry& instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    void setEnabled(bool enabled) { metricsEnabled.store(enabled, memory_order_relaxed); }
+    bool isEnabled() const { return metricsActive(); }
+
+    void record(const char* name, double seconds, const uint64_t* counterDeltas) {
+        lock_guard<mutex> guard(lock);
+        PhaseMetrics* phase = nullptr;
+        for (PhaseMetrics& p : phases)
+            if (p.name == name) phase = &p;
+        if (phase == nullptr) {
+            phases.emplace_back();
+            phase = &phases.back();
+            phase->name = name;
+        }
+        phase->calls++;
+        phase->seconds += seconds;
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c) phase->counters[c] += counterDeltas[c];
+    }
+
+    void reset() {
+        lock_guard<mutex> guard(lock);
+        phases.clear();
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c) metricCounters[c].store(0, memory_order_relaxed);
+    }
+
+    vector<PhaseMetrics> getPhases() const {
+        lock_guard<mutex> guard(lock);
+        return phases;
+    }
+
+    uint64_t getCounter(MetricCounter counter) const { return metricCounters[counter].load(memory_order_relaxed); }
+
+    void display(ostream& out) const {
+        vector<PhaseMetrics> snapshot = getPhases();
+        out << "\n--- Run Metrics (" << (isEnabled() ? "enabled" : "disabled") << ") ---\n";
+        if (snapshot.empty()) out << "No phases recorded.\n";
+        for (const PhaseMetrics& p : snapshot) {
+            out << p.name << ": " << p.seconds << " s over " << p.calls << " call(s)";
+            for (int c = 0; c < METRIC_COUNTER_COUNT; ++c)
+                if (p.counters[c] != 0) out << " | " << METRIC_COUNTER_NAMES[c] << ": " << p.counters[c];
+            out << "\n";
+        }
+        out << "Totals:";
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c)
+            out << " " << METRIC_COUNTER_NAMES[c] << "=" << getCounter((MetricCounter)c);
+        out << "\n----------------------------\n";
+    }
+
+    void exportJson(ostream& out) const {
+        vector<PhaseMetrics> snapshot = getPhases();
+        out << "{\"phases\":[";
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            const PhaseMetrics& p = snapshot[i];
+            out << (i > 0 ? "," : "") << "{\"name\":\"" << p.name << "\",\"calls\":" << p.calls
+                << ",\"seconds\":" << to_string(p.seconds);
+            for (int c = 0; c < METRIC_COUNTER_COUNT; ++c)
+                out << ",\"" << METRIC_COUNTER_NAMES[c] << "\":" << p.counters[c];
+            out << "}";
+        }
+        out << "],\"totals\":{";
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c)
+            out << (c > 0 ? "," : "") << "\"" << METRIC_COUNTER_NAMES[c] << "\":" << getCounter((MetricCounter)c);
+        out << "}}\n";
+    }
+
+    // One row per phase, then a "total" row with the process-wide counters
+    void exportCsv(ostream& out) const {
+        vector<PhaseMetrics> snapshot = getPhases();
+        out << "phase,calls,seconds";
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c) out << "," << METRIC_COUNTER_NAMES[c];
+        out << "\n";
+        for (const PhaseMetrics& p : snapshot) {
+            out << p.name << "," << p.calls << "," << to_string(p.seconds);
+            for (int c = 0; c < METRIC_COUNTER_COUNT; ++c) out << "," << p.counters[c];
+            out << "\n";
+        }
+        out << "total,,";
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c) out << "," << getCounter((MetricCounter)c);
+        out << "\n";
+    }
+};
+
+// Times the enclosing scope as one call of a phase. `name` must outlive the
+// scope (a string literal). Does nothing if metrics were off when it started.
+class ScopedPhase {
+private:
+    const char* name;
+    bool active;
+    chrono::steady_clock::time_point start;
+    uint64_t startCounters[METRIC_COUNTER_COUNT];
+
+public:
+    explicit ScopedPhase(const char* phaseName) : name(phaseName), active(metricsActive()) {
+        if (!active) return;
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c)
+            startCounters[c] = metricCounters[c].load(memory_order_relaxed);
+        start = chrono::steady_clock::now();
+    }
+
+    ~ScopedPhase() {
+        if (!active) return;
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        uint64_t deltas[METRIC_COUNTER_COUNT];
+        for (int c = 0; c < METRIC_COUNTER_COUNT; ++c)
+            deltas[c] = metricCounters[c].load(memory_order_relaxed) - startCounters[c];
+        MetricsRegistry::instance().record(name, seconds, deltas);
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+};
+
+// Replacing the global operator new has to happen in exactly one translation
+// unit; the program that wants allocation counts defines this macro before
+// its first include. GCC flags the free() in the deletes because it pairs
+// them with the new expressions it inlined, but both sides are replaced here.
+#ifdef METRICS_ALLOCATION_HOOKS
+void* operator new(size_t size) {
+    if (metricsActive()) {
+        metricCounters[METRIC_ALLOCATIONS].fetch_add(1, memory_order_relaxed);
+        metricCounters[METRIC_ALLOCATED_BYTES].fetch_add(size, memory_order_relaxed);
+    }
+    void* p = malloc(size > 0 ? size : 1);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef ORDER_STATISTIC_TREE_HPP
+#define ORDER_STATISTIC_TREE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+// Nonnegative fraction num / den (den > 0), so ranking values that are equal
+// as rationals compare equal however they were computed
+struct RankValue {
+    uint64_t num;
+    uint64_t den;
+};
+
+// Exact comparison of two RankValues: -1, 0 or 1. Compares the integer parts,
+// then the reciprocals of the remainders, as in a continued fraction; no
+// product is formed, so nothing can overflow.
+inline int compareRankValues(RankValue a, RankValue b) {
+    int sign = 1;
+    for (;;) {
+        const uint64_t aWhole = a.num / a.den, bWhole = b.num / b.den;
+        if (aWhole != bWhole) return aWhole < bWhole ? -sign : sign;
+        a.num %= a.den;
+        b.num %= b.den;
+        if (a.num == 0 || b.num == 0) return (a.num == b.num) ? 0 : (a.num == 0 ? -sign : sign);
+        swap(a.num, a.den);
+        swap(b.num, b.den);
+        sign = -sign;
+    }
+}
+
+// Sort key of one ranked item: higher primary first, then higher secondary,
+// then lower id; the item index breaks any remaining tie, so keys are unique.
+struct RankKey {
+    RankValue primary;
+    RankValue secondary;
+    int id;
+    int item;
+};
+
+inline bool ranksBefore(const RankKey& a, const RankKey& b) {
+    if (int c = compareRankValues(a.primary, b.primary)) return c > 0;
+    if (int c = compareRankValues(a.secondary, b.secondary)) return c > 0;
+    if (a.id != b.id) return a.id < b.id;
+    return a.item < b.item;
+}
+
+// AVL tree over items 0..n-1, ordered by RankKey, where every node also counts
+// the nodes of its subtree. Inserting, removing or re-keying an item and
+// finding the item at a rank, or the rank of an item, are all O(log n); a page
+// of `limit` items from any rank is O(log n + limit). Nodes live in arrays
+// indexed by item, so an item is found without a search.
+class OrderStatisticTree {
+private:
+    enum { NONE = -1 };
+
+    vector<RankKey> keys;
+    vector<int> left;
+    vector<int> right;
+    vector<int> subtreeSize;
+    vector<int8_t> height;      // 0 when the item is not in the tree
+    int root;
+
+    int sizeOf(int node) const { return node == NONE ? 0 : subtreeSize[node]; }
+    int heightOf(int node) const { return node == NONE ? 0 : height[node]; }
+
+    void refresh(int node) {
+        subtreeSize[node] = 1 + sizeOf(left[node]) + sizeOf(right[node]);
+        height[node] = (int8_t)(1 + max(heightOf(left[node]), heightOf(right[node])));
+    }
+
+    int rotateRight(int node) {
+        int pivot = left[node];
+        left[node] = right[pivot];
+        right[pivot] = node;
+        refresh(node);
+        refresh(pivot);
+        return pivot;
+    }
+
+    int rotateLeft(int node) {
+        int pivot = right[node];
+        right[node] = left[pivot];
+        left[pivot] = node;
+        refresh(node);
+        refresh(pivot);
+        return pivot;
+    }
+
+    int rebalance(int node) {
+        refresh(node);
+        const int balance = heightOf(left[node]) - heightOf(right[node]);
+        if (balance > 1) {
+            if (heightOf(left[left[node]]) < heightOf(right[left[node]])) left[node] = rotateLeft(left[node]);
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (heightOf(right[right[node]]) < heightOf(left[right[node]])) right[node] = rotateRight(right[node]);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    int insertAt(int node, int item) {
+        if (node == NONE) {
+            refresh(item);
+            return item;
+        }
+        if (ranksBefore(keys[item], keys[node])) left[node] = insertAt(left[node], item);
+        else right[node] = insertAt(right[node], item);
+        return rebalance(node);
+    }
+
+    // Detaches the first node of the subtree into `first`
+    int eraseFirst(int node, int& first) {
+        if (left[node] == NONE) {
+            first = node;
+            return right[node];
+        }
+        left[node] = eraseFirst(left[node], first);
+        return rebalance(node);
+    }
+
+    int eraseAt(int node, int item) {
+        if (node == item) {
+            if (left[node] == NONE) return right[node];
+            if (right[node] == NONE) return left[node];
+            int successor;
+            int rest = eraseFirst(right[node], successor);
+            left[successor] = left[node];
+            right[successor] = rest;
+            return rebalance(successor);
+        }
+        if (ranksBefore(keys[item], keys[node])) left[node] = eraseAt(left[node], item);
+        else right[node] = eraseAt(right[node], item);
+        return rebalance(node);
+    }
+
+    // Balanced subtree over sorted[begin, end)
+    int buildRange(const vector<int>& sorted, int begin, int end) {
+        if (begin >= end) return NONE;
+        const int mid = begin + (end - begin) / 2;
+        const int node = sorted[mid];
+        left[node] = buildRange(sorted, begin, mid);
+        right[node] = buildRange(sorted, mid + 1, end);
+        refresh(node);
+        return node;
+    }
+
+    void ensureCapacity(int item) {
+        if (item < (int)keys.size()) return;
+        keys.resize(item + 1);
+        left.resize(item + 1, NONE);
+        right.resize(item + 1, NONE);
+        subtreeSize.resize(item + 1, 0);
+        height.resize(item + 1, 0);
+    }
+
+public:
+    OrderStatisticTree() : root(NONE) {}
+
+    void clear() {
+        keys.clear();
+        left.clear();
+        right.clear();
+        subtreeSize.clear();
+        height.clear();
+        root = NONE;
+    }
+
+    // Replaces the contents with one key per item; O(n log n) for the sort
+    void build(const vector<RankKey>& itemKeys) {
+        clear();
+        const int count = (int)itemKeys.size();
+        if (count == 0) return;
+        ensureCapacity(count - 1);
+        vector<int> sorted(count);
+        for (int i = 0; i < count; ++i) {
+            keys[itemKeys[i].item] = itemKeys[i];
+            sorted[i] = itemKeys[i].item;
+        }
+        sort(sorted.begin(), sorted.end(), [&](int a, int b) { return ranksBefore(keys[a], keys[b]); });
+        root = buildRange(sorted, 0, count);
+    }
+
+    int size() const { return sizeOf(root); }
+    bool contains(int item) const { return item >= 0 && item < (int)height.size() && height[item] != 0; }
+
+    // Inserts the item, or moves it if its key changed
+    void update(const RankKey& key) {
+        erase(key.item);
+        ensureCapacity(key.item);
+        keys[key.item] = key;
+        left[key.item] = right[key.item] = NONE;
+        root = insertAt(root, key.item);
+    }
+
+    void erase(int item) {
+        if (!contains(item)) return;
+        root = eraseAt(root, item);
+        height[item] = 0;
+    }
+
+    // Item at a 0-based rank, or -1 past the end
+    int select(int rank) const {
+        int node = root;
+        while (node != NONE) {
+            const int leftSize = sizeOf(left[node]);
+            if (rank < leftSize) {
+                node = left[node];
+            } else if (rank == leftSize) {
+                return node;
+            } else {
+                rank -= leftSize + 1;
+                node = right[node];
+            }
+        }
+        return NONE;
+    }
+
+    // 0-based rank of an item, or -1 when it is not in the tree
+    int rankOf(int item) const {
+        if (!contains(item)) return NONE;
+        int rank = 0;
+        int node = root;
+        while (node != item) {
+            if (ranksBefore(keys[item], keys[node])) {
+                node = left[node];
+            } else {
+                rank += sizeOf(left[node]) + 1;
+                node = right[node];
+            }
+        }
+        return rank + sizeOf(left[item]);
+    }
+
+    // Items at ranks [offset, offset + limit), in rank order; limit < 0 means to the end
+    vector<int> range(int offset, int limit) const {
+        vector<int> items;
+        const int count = size();
+        if (offset < 0) offset = 0;
+        if (offset >= count || limit == 0) return items;
+        const int end = (limit < 0 || limit > count - offset) ? count : offset + limit;
+        items.reserve(end - offset);
+
+        // Path to the item at `offset`, keeping the nodes still to be visited in order
+        vector<int> pending;
+        int node = root;
+        int rank = offset;
+        while (node != NONE) {
+            const int leftSize = sizeOf(left[node]);
+            if (rank < leftSize) {
+                pending.push_back(node);
+                node = left[node];
+            } else if (rank == leftSize) {
+                pending.push_back(node);
+                break;
+            } else {
+                rank -= leftSize + 1;
+                node = right[node];
+            }
+        }
+        while ((int)items.size() < end - offset) {
+            node = pending.back();
+            pending.pop_back();
+            items.push_back(node);
+            for (int next = right[node]; next != NONE; next = left[next]) pending.push_back(next);
+        }
+        return items;
+    }
+
+    size_t getMemoryUsage() const {
+        return keys.capacity() * sizeof(RankKey)
+             + (left.capacity() + right.capacity() + subtreeSize.capacity()) * sizeof(int)
+             + height.capacity() * sizeof(int8_t);
+    }
+};
+
+#endif
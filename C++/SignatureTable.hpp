@@ -0,0 +1,82 @@
+#ifndef SIGNATURE_TABLE_HPP
+#define SIGNATURE_TABLE_HPP
+
+#include <vector>
+#include <cstdint>
+#include "SkillVector.hpp"
+using namespace std;
+
+// Finalizer of splitmix64; spreads nearby masks across the whole table
+inline uint64_t hashSkillMask(SkillMask m) {
+    m ^= m >> 30;
+    m *= 0xBF58476D1CE4E5B9ULL;
+    m ^= m >> 27;
+    m *= 0x94D049BB133111EBULL;
+    m ^= m >> 31;
+    return m;
+}
+
+// Groups items that share the exact same skill signature. Groups are numbered in
+// order of first appearance, so each group's representative is its lowest item
+// index and scanning groups in order preserves the first-item-wins tie-break.
+class SignatureGroups {
+private:
+    vector<int> slots;   // open addressing, linear probing; -1 = empty, else group id
+
+public:
+    vector<SkillMask> signatures;   // per group
+    vector<int> representative;     // per group: first item with that signature
+    vector<int> groupOf;            // per item
+    vector<int> memberOffsets;      // CSR: members of group g are members[memberOffsets[g] .. memberOffsets[g + 1])
+    vector<int> members;            // item indices, ascending within each group
+
+private:
+    void buildMembers() {
+        const int groups = size();
+        memberOffsets.assign(groups + 1, 0);
+        for (int g : groupOf) memberOffsets[g + 1]++;
+        for (int g = 0; g < groups; ++g) memberOffsets[g + 1] += memberOffsets[g];
+        members.resize(groupOf.size());
+        vector<int> cursor(memberOffsets.begin(), memberOffsets.end() - 1);
+        for (int i = 0; i < (int)groupOf.size(); ++i) members[cursor[groupOf[i]]++] = i;
+    }
+
+public:
+    int size() const { return (int)signatures.size(); }
+
+    void build(const SkillMask* keys, int count) {
+        signatures.clear();
+        representative.clear();
+        groupOf.resize(count);
+
+        size_t capacity = 16;
+        while (capacity < (size_t)count * 2) capacity <<= 1;
+        slots.assign(capacity, -1);
+        const size_t mask = capacity - 1;
+
+        for (int i = 0; i < count; ++i) {
+            size_t slot = hashSkillMask(keys[i]) & mask;
+            while (slots[slot] >= 0 && signatures[slots[slot]] != keys[i])
+                slot = (slot + 1) & mask;
+            if (slots[slot] < 0) {
+                slots[slot] = (int)signatures.size();
+                signatures.push_back(keys[i]);
+                representative.push_back(i);
+            }
+            groupOf[i] = slots[slot];
+        }
+        buildMembers();
+    }
+
+    // Every item in its own group, for running with deduplication switched off
+    void buildIdentity(const SkillMask* keys, int count) {
+        signatures.assign(keys, keys + count);
+        representative.resize(count);
+        groupOf.resize(count);
+        for (int i = 0; i < count; ++i) representative[i] = groupOf[i] = i;
+        slots.clear();
+        buildMembers();
+    }
+};
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef SKILL_GRAPH_HPP
+#define SKILL_GRAPH_HPP
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include "SkillVector.hpp"
+#include "LinkedListNodes.hpp"
+#include "ThreadPool.hpp"
+#include "TopK.hpp"
+#include "Metrics.hpp"
+using namespace std;
+
+// A job or resume together with how many skills it shares with the query job
+struct GraphHit {
+    int index;      // column index
+    int shared;
+};
+
+// Bipartite graph of the keyword skill bits: every job and resume is joined to
+// each skill its mask holds. Vertices are numbered jobs first, then skills,
+// then resumes, and the edges are stored in compressed sparse row form: one
+// array of targets grouped by source vertex, each group ascending, and an
+// offsets array into it. A skill's jobs are therefore a prefix of its group,
+// ending where its resumes begin.
+//
+// Built from preprocessed columns; it refers to jobs and resumes by column
+// index and must be rebuilt once either list changes.
+class SkillGraph {
+private:
+    int jobCount;
+    int skillCount;
+    int resumeCount;
+    vector<int> offsets;        // vertex -> first edge; vertexCount() + 1 entries
+    vector<int> targets;
+    vector<int> skillResumes;   // skill -> first edge of its resumes
+
+    // Number of jobs (or resumes) sharing each skill with the job, counted over
+    // job -> skill -> item paths; returns the items reached, in the order found
+    vector<int> countShared(int job, bool resumes, vector<int>& shared) const {
+        vector<int> reached;
+        shared.assign(resumes ? resumeCount : jobCount, 0);
+        const int base = resumes ? jobCount + skillCount : 0;
+        for (int e = offsets[job]; e < offsets[job + 1]; ++e) {
+            const int skill = targets[e] - jobCount;
+            const int first = resumes ? skillResumes[skill] : offsets[targets[e]];
+            const int last = resumes ? offsets[targets[e] + 1] : skillResumes[skill];
+            for (int n = first; n < last; ++n) {
+                const int item = targets[n] - base;
+                if (shared[item]++ == 0) reached.push_back(item);
+            }
+        }
+        return reached;
+    }
+
+    static vector<GraphHit> rankHits(const vector<int>& reached, const vector<int>& shared, int exclude, int limit) {
+        TopKHeap<int> best;
+        best.reset(min(limit, (int)reached.size()));
+        for (int item : reached)
+            if (item != exclude) best.push(shared[item], item);
+        vector<GraphHit> hits;
+        for (const auto& entry : best.sorted()) hits.push_back(GraphHit{entry.index, entry.score});
+        return hits;
+    }
+
+public:
+    SkillGraph() : jobCount(0), skillCount(0), resumeCount(0), offsets(1, 0) {}
+
+    // `skills` is the number of keyword bits in use, at most 64
+    void build(const JobColumns& jobs, const ResumeColumns& resumes, int skills) {
+        ScopedPhase phase("graph.build");
+        jobCount = jobs.size();
+        skillCount = skills;
+        resumeCount = resumes.size();
+        const int vertices = vertexCount();
+        const SkillMask used = (skills >= 64) ? ~SkillMask(0) : ((SkillMask(1) << skills) - 1);
+
+        // Degrees, then offsets by prefix sum
+        vector<int> degree(vertices, 0);
+        auto countItem = [&](int vertex, SkillMask mask) {
+            mask &= used;
+            degree[vertex] = popcount64(mask);
+            for (; mask != 0; mask &= mask - 1) degree[skillVertex(countTrailingZeros(mask))]++;
+        };
+        for (int j = 0; j < jobCount; ++j) countItem(jobVertex(j), jobs.skillMask[j]);
+        for (int r = 0; r < resumeCount; ++r) countItem(resumeVertex(r), resumes.skillMask[r]);
+        offsets.assign(vertices + 1, 0);
+        for (int v = 0; v < vertices; ++v) offsets[v + 1] = offsets[v] + degree[v];
+
+        // Items are visited in vertex order, so every skill's group comes out ascending
+        targets.assign(offsets[vertices], 0);
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        auto linkItem = [&](int vertex, SkillMask mask) {
+            for (mask &= used; mask != 0; mask &= mask - 1) {
+                const int skill = skillVertex(countTrailingZeros(mask));
+                targets[cursor[vertex]++] = skill;
+                targets[cursor[skill]++] = vertex;
+            }
+        };
+        for (int j = 0; j < jobCount; ++j) linkItem(jobVertex(j), jobs.skillMask[j]);
+        skillResumes.resize(skillCount);
+        for (int s = 0; s < skillCount; ++s) skillResumes[s] = cursor[skillVertex(s)];
+        for (int r = 0; r < resumeCount; ++r) linkItem(resumeVertex(r), resumes.skillMask[r]);
+    }
+
+    int vertexCount() const { return jobCount + skillCount + resumeCount; }
+    int edgeCount() const { return (int)targets.size() / 2; }
+    int getJobCount() const { return jobCount; }
+    int getResumeCount() const { return resumeCount; }
+
+    int jobVertex(int job) const { return job; }
+    int skillVertex(int skill) const { return jobCount + skill; }
+    int resumeVertex(int resume) const { return jobCount + skillCount + resume; }
+
+    // Skill bits of a job, ascending
+    vector<int> jobSkills(int job) const {
+        vector<int> skills;
+        for (int e = offsets[job]; e < offsets[job + 1]; ++e) skills.push_back(targets[e] - jobCount);
+        return skills;
+    }
+
+    // Jobs sharing the most skills with `job`, most first, equal counts by lower
+    // index; only jobs sharing at least one skill are returned
+    vector<GraphHit> similarJobs(int job, int limit) const {
+        ScopedPhase phase("graph.similar");
+        vector<int> shared;
+        vector<int> reached = countShared(job, false, shared);
+        return rankHits(reached, shared, job, limit);
+    }
+
+    // Resumes that mention any of the job's skills, ranked like similarJobs;
+    // `reachable` receives how many there are in all
+    vector<GraphHit> resumesForJob(int job, int limit, int& reachable) const {
+        ScopedPhase phase("graph.resumes");
+        vector<int> shared;
+        vector<int> reached = countShared(job, true, shared);
+        reachable = (int)reached.size();
+        return rankHits(reached, shared, -1, limit);
+    }
+
+    // Hops from `source` to every vertex, -1 where unreachable. Level by level,
+    // each level's frontier is split across the pool; a vertex is claimed by
+    // whichever worker sets its hop count first, which does not change the
+    // count itself, so the result is the same for any thread count.
+    vector<int> parallelBfs(int source, int threadCount) const {
+        ScopedPhase phase("graph.bfs");
+        const int vertices = vertexCount();
+        vector<atomic<int>> hops(vertices);
+        for (int v = 0; v < vertices; ++v) hops[v].store(-1, memory_order_relaxed);
+        WorkStealingPool pool(threadCount);
+        vector<vector<int>> found(pool.getThreadCount());
+
+        vector<int> frontier(1, source);
+        hops[source].store(0, memory_order_relaxed);
+        for (int level = 1; !frontier.empty(); ++level) {
+            // Small grains: a frontier of a few hub skills still spreads over the workers
+            int grain = (int)frontier.size() / (pool.getThreadCount() * 8);
+            if (grain < 1) grain = 1;
+            pool.parallelFor((int)frontier.size(), grain, [&](int begin, int end, int worker) {
+                vector<int>& next = found[worker];
+                for (int i = begin; i < end; ++i) {
+                    const int v = frontier[i];
+                    for (int e = offsets[v]; e < offsets[v + 1]; ++e) {
+                        const int u = targets[e];
+                        int unseen = -1;
+                        // Plain load first: hub skills are seen by most of the frontier
+                        if (hops[u].load(memory_order_relaxed) == -1 &&
+                            hops[u].compare_exchange_strong(unseen, level, memory_order_relaxed))
+                            next.push_back(u);
+                    }
+                }
+            });
+            frontier.clear();
+            for (vector<int>& next : found) {
+                frontier.insert(frontier.end(), next.begin(), next.end());
+                next.clear();
+            }
+        }
+
+        vector<int> result(vertices);
+        for (int v = 0; v < vertices; ++v) result[v] = hops[v].load(memory_order_relaxed);
+        return result;
+    }
+
+    size_t getMemoryUsage() const {
+        return (offsets.capacity() + targets.capacity() + skillResumes.capacity()) * sizeof(int);
+    }
+};
+
+#endif
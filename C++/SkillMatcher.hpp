@@ -0,0 +1,173 @@
+#ifndef SKILL_MATCHER_HPP
+#define SKILL_MATCHER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include "SkillVector.hpp"
+using namespace std;
+
+// Skill vectors produced by one scan of a description
+struct SkillHits {
+    SkillMask keyword;
+    SkillMask critical;
+    SkillMask core;
+    SkillMask soft;
+
+    SkillHits() : keyword(0), critical(0), core(0), soft(0) {}
+
+    void merge(const SkillHits& other) {
+        keyword |= other.keyword;
+        critical |= other.critical;
+        core |= other.core;
+        soft |= other.soft;
+    }
+};
+
+enum SkillTier { TIER_KEYWORD, TIER_CRITICAL, TIER_CORE, TIER_SOFT };
+
+// ASCII-only lowercase; other bytes, including UTF-8 sequences, are unchanged
+inline unsigned char asciiLower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+// Aho-Corasick automaton over every skill of every tier, behind the substring
+// match mode. The goto and failure links are folded into a dense DFA over
+// byte classes, so a scan is one table lookup per input byte no matter how
+// many skills the taxonomy holds.
+// Matching ignores ASCII case: an uppercase letter shares its lowercase
+// letter's class, so text is scanned as is, without a lowercased copy.
+class SkillMatcher {
+private:
+    enum { ROOT = 0 };
+
+    struct TrieNode {
+        int children[256];
+        int fail;
+        SkillHits hits;
+        bool terminal;
+        TrieNode() : fail(ROOT), terminal(false) {
+            for (int i = 0; i < 256; ++i) children[i] = -1;
+        }
+    };
+
+    vector<TrieNode> trie;          // only used while building
+    uint8_t byteClass[256];         // byte -> column of the transition table
+    int classCount;
+    vector<int> transitions;        // state * classCount + class -> next state
+    vector<int> outputIndex;        // state -> index into outputs, -1 when none
+    vector<SkillHits> outputs;
+    bool built;
+    uint64_t fingerprint;           // FNV-1a over every (pattern, tier, bit) added
+
+public:
+    SkillMatcher() : classCount(1), built(false), fingerprint(0xCBF29CE484222325ULL) {
+        trie.push_back(TrieNode());
+        for (int i = 0; i < 256; ++i) byteClass[i] = 0;
+    }
+
+    void addPattern(const char* pattern, SkillTier tier, int bit) {
+        int state = ROOT;
+        for (const char* p = pattern; *p; ++p) {
+            unsigned char c = asciiLower((unsigned char)*p);
+            fingerprint = (fingerprint ^ c) * 0x100000001B3ULL;
+            if (trie[state].children[c] < 0) {
+                trie[state].children[c] = (int)trie.size();
+                trie.push_back(TrieNode());
+            }
+            state = trie[state].children[c];
+        }
+        SkillMask flag = SkillMask(1) << bit;
+        switch (tier) {
+            case TIER_KEYWORD:  trie[state].hits.keyword |= flag; break;
+            case TIER_CRITICAL: trie[state].hits.critical |= flag; break;
+            case TIER_CORE:     trie[state].hits.core |= flag; break;
+            case TIER_SOFT:     trie[state].hits.soft |= flag; break;
+        }
+        trie[state].terminal = true;
+        // A byte outside any pattern separates entries; then tier and bit
+        fingerprint = (fingerprint ^ 0xFF) * 0x100000001B3ULL;
+        fingerprint = (fingerprint ^ (uint64_t)(tier * 64 + bit)) * 0x100000001B3ULL;
+    }
+
+    void build() {
+        // Bytes that never occur in a pattern share class 0
+        classCount = 1;
+        for (size_t s = 0; s < trie.size(); ++s)
+            for (int c = 0; c < 256; ++c)
+                if (trie[s].children[c] >= 0 && byteClass[c] == 0)
+                    byteClass[c] = (uint8_t)classCount++;
+        // Patterns are lowercase, so uppercase letters never got a class of their own
+        for (int c = 'A'; c <= 'Z'; ++c) byteClass[c] = byteClass[asciiLower((unsigned char)c)];
+
+        const int stateCount = (int)trie.size();
+        transitions.assign((size_t)stateCount * classCount, ROOT);
+        outputIndex.assign(stateCount, -1);
+        outputs.clear();
+
+        // Breadth-first so a node's failure target is complete before the node itself
+        queue<int> pending;
+        pending.push(ROOT);
+        while (!pending.empty()) {
+            int s = pending.front();
+            pending.pop();
+
+            SkillHits merged = trie[s].hits;
+            bool terminal = trie[s].terminal;
+            if (s != ROOT) {
+                int f = trie[s].fail;
+                if (outputIndex[f] >= 0) {
+                    merged.merge(outputs[outputIndex[f]]);
+                    terminal = true;
+                }
+            }
+            if (terminal) {
+                outputIndex[s] = (int)outputs.size();
+                outputs.push_back(merged);
+            }
+
+            for (int c = 0; c < 256; ++c) {
+                int cls = byteClass[c];
+                if (cls == 0 || asciiLower((unsigned char)c) != c) continue;   // uppercase aliases its lowercase class
+                int child = trie[s].children[c];
+                if (child >= 0) {
+                    trie[child].fail = (s == ROOT) ? ROOT : transitions[(size_t)trie[s].fail * classCount + cls];
+                    transitions[(size_t)s * classCount + cls] = child;
+                    pending.push(child);
+                } else {
+                    transitions[(size_t)s * classCount + cls] =
+                        (s == ROOT) ? ROOT : transitions[(size_t)trie[s].fail * classCount + cls];
+                }
+            }
+        }
+
+        trie.clear();
+        trie.shrink_to_fit();
+        built = true;
+    }
+
+    SkillHits scan(const char* text, size_t length) const {
+        SkillHits hits;
+        int state = ROOT;
+        const int* table = transitions.data();
+        for (size_t i = 0; i < length; ++i) {
+            state = table[(size_t)state * classCount + byteClass[(unsigned char)text[i]]];
+            int out = outputIndex[state];
+            if (out >= 0) hits.merge(outputs[out]);
+        }
+        return hits;
+    }
+
+    SkillHits scan(string_view text) const {
+        return scan(text.data(), text.size());
+    }
+
+    int getStateCount() const { return (int)outputIndex.size(); }
+
+    // Changes whenever the skill taxonomy does; stored with saved skill masks
+    uint64_t getFingerprint() const { return fingerprint; }
+};
+
+#endif
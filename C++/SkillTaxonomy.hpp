@@ -0,0 +1,478 @@
+#ifndef SKILL_TAXONOMY_HPP
+#define SKILL_TAXONOMY_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "SkillVector.hpp"
+#include "SkillMatcher.hpp"
+#include "SkillTokenizer.hpp"
+using namespace std;
+
+// The skill taxonomy: the skills both algorithms look for, the weighted tier
+// of each skill, the points a tier is worth and the aliases that count as the
+// same skill. The built-in taxonomy is the constexpr table below; a taxonomy
+// file can replace it at startup. Either one is compiled once into a matcher
+// and a packed tier layout that every algorithm instance shares read-only.
+//
+// Skills live in 64-bit masks, so a taxonomy holds at most 64 keyword skills
+// and 64 weighted skills over all three tiers. Adding a skill below those
+// limits needs no code change and makes no node bigger.
+
+static const int SKILL_MASK_BITS = 64;
+
+struct TaxonomyEntry {
+    const char* name;
+    bool keyword;           // scored by KeywordAlgorithm
+    SkillTier tier;         // TIER_CRITICAL, TIER_CORE or TIER_SOFT; TIER_KEYWORD for none
+    const char* aliases;    // comma-separated, "" for none
+};
+
+// Bits are assigned in table order: keyword bit i is the i-th keyword skill,
+// and each tier numbers its own skills the same way
+constexpr TaxonomyEntry DEFAULT_TAXONOMY[] = {
+    {"python", true, TIER_CORE, ""},
+    {"java", true, TIER_CORE, ""},
+    {"javascript", true, TIER_CORE, ""},
+    {"c++", true, TIER_CORE, ""},
+    {"sql", true, TIER_CORE, ""},
+    {"excel", true, TIER_SOFT, ""},
+    {"power bi", true, TIER_SOFT, ""},
+    {"tableau", true, TIER_SOFT, ""},
+    {"pandas", true, TIER_SOFT, ""},
+    {"machine learning", true, TIER_CRITICAL, ""},
+    {"deep learning", true, TIER_CRITICAL, ""},
+    {"nlp", true, TIER_CORE, ""},
+    {"statistics", true, TIER_SOFT, ""},
+    {"data cleaning", true, TIER_KEYWORD, ""},
+    {"reporting", true, TIER_KEYWORD, ""},
+    {"tensorflow", true, TIER_CRITICAL, ""},
+    {"keras", true, TIER_CRITICAL, ""},
+    {"mlops", true, TIER_CRITICAL, ""},
+    {"computer vision", true, TIER_CRITICAL, ""},
+    {"spring boot", true, TIER_CORE, ""},
+    {"rest apis", true, TIER_CORE, ""},
+    {"docker", true, TIER_CORE, ""},
+    {"git", true, TIER_SOFT, ""},
+    {"system design", true, TIER_CORE, ""},
+    {"agile", true, TIER_SOFT, ""},
+    {"data analyst", true, TIER_KEYWORD, ""},
+    {"data scientist", true, TIER_KEYWORD, ""},
+    {"software engineer", true, TIER_KEYWORD, ""},
+    {"ml engineer", true, TIER_KEYWORD, ""},
+    {"developer", true, TIER_KEYWORD, ""},
+    {"engineer", true, TIER_KEYWORD, ""},
+    {"experience", true, TIER_KEYWORD, ""},
+    {"professional", true, TIER_KEYWORD, ""}
+};
+
+constexpr int DEFAULT_CRITICAL_WEIGHT = 3;
+constexpr int DEFAULT_CORE_WEIGHT = 2;
+constexpr int DEFAULT_SOFT_WEIGHT = 1;
+constexpr int DEFAULT_MIN_JOB_POINTS = 5;
+// Keeps the points of 64 skills at the largest weight inside an int; comparing
+// two scores multiplies two such values, which WeightedScore does in long long
+constexpr int MAX_TIER_WEIGHT = 1000;
+
+constexpr int defaultKeywordCount() {
+    int count = 0;
+    for (const TaxonomyEntry& entry : DEFAULT_TAXONOMY) count += entry.keyword ? 1 : 0;
+    return count;
+}
+
+constexpr int defaultTierCount(SkillTier tier) {
+    int count = 0;
+    for (const TaxonomyEntry& entry : DEFAULT_TAXONOMY) count += (entry.tier == tier) ? 1 : 0;
+    return count;
+}
+
+// `count` bits starting at bit `from`
+constexpr SkillMask bitRange(int from, int count) {
+    return count == 0 ? 0 : (count >= SKILL_MASK_BITS ? ~SkillMask(0) : ((SkillMask(1) << count) - 1) << from);
+}
+
+// The weighted tiers packed side by side into one mask: critical skills in the
+// low bits, then core, then soft. `points` weighs a packed mask.
+struct TierLayout {
+    int counts[3];              // critical, core, soft skills
+    int coreShift;
+    int softShift;
+    BitWeights points;
+    int minJobPoints;           // jobs worth fewer points always score 0
+
+    constexpr TierLayout(int critical, int core, int soft,
+                         int criticalWeight, int coreWeight, int softWeight, int minPoints)
+        : counts{critical, core, soft}, coreShift(critical), softShift(critical + core),
+          points{{bitRange(0, critical), bitRange(critical, core), bitRange(critical + core, soft)},
+                 {criticalWeight, coreWeight, softWeight}},
+          minJobPoints(minPoints) {}
+
+    SkillMask pack(SkillMask critical, SkillMask core, SkillMask soft) const {
+        return critical | (core << coreShift) | (soft << softShift);
+    }
+
+    int weight(SkillMask packed) const { return weighBits(points, packed); }
+};
+
+static_assert(defaultKeywordCount() <= SKILL_MASK_BITS, "too many keyword skills for a SkillMask");
+static_assert(defaultTierCount(TIER_CRITICAL) + defaultTierCount(TIER_CORE) + defaultTierCount(TIER_SOFT)
+              <= SKILL_MASK_BITS, "too many weighted skills for a packed SkillMask");
+
+constexpr TierLayout DEFAULT_TIER_LAYOUT(defaultTierCount(TIER_CRITICAL), defaultTierCount(TIER_CORE),
+                                         defaultTierCount(TIER_SOFT), DEFAULT_CRITICAL_WEIGHT,
+                                         DEFAULT_CORE_WEIGHT, DEFAULT_SOFT_WEIGHT, DEFAULT_MIN_JOB_POINTS);
+
+// How descriptions are searched for skills: whole words and phrases through
+// SkillTokenizer (default), or any substring through the SkillMatcher
+// automaton, which also finds "java" inside "javascript"
+enum SkillMatchMode { SKILL_MATCH_WORDS, SKILL_MATCH_SUBSTRINGS };
+
+inline const char* skillMatchModeName(SkillMatchMode mode) {
+    return mode == SKILL_MATCH_WORDS ? "words" : "substrings";
+}
+
+inline bool parseSkillMatchMode(const string& name, SkillMatchMode& mode) {
+    if (name == "words") mode = SKILL_MATCH_WORDS;
+    else if (name == "substrings") mode = SKILL_MATCH_SUBSTRINGS;
+    else return false;
+    return true;
+}
+
+// A taxonomy as written, before it is checked and compiled
+struct TaxonomySkill {
+    string name;
+    bool keyword = false;
+    SkillTier tier = TIER_KEYWORD;
+    vector<string> aliases;
+};
+
+struct TaxonomySource {
+    string origin = "built-in";
+    vector<TaxonomySkill> skills;
+    int weights[3] = {DEFAULT_CRITICAL_WEIGHT, DEFAULT_CORE_WEIGHT, DEFAULT_SOFT_WEIGHT};
+    int minJobPoints = DEFAULT_MIN_JOB_POINTS;
+    SkillMatchMode matchMode = SKILL_MATCH_WORDS;
+};
+
+inline string trimCopy(const string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+inline string lowerCopy(string text) {
+    for (char& c : text) c = (char)asciiLower((unsigned char)c);
+    return text;
+}
+
+// Comma-separated names, trimmed and lowercased; empty items are dropped
+inline vector<string> splitNames(const string& text) {
+    vector<string> names;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == string::npos) comma = text.size();
+        string name = lowerCopy(trimCopy(text.substr(start, comma - start)));
+        if (!name.empty()) names.push_back(name);
+        start = comma + 1;
+    }
+    return names;
+}
+
+inline TaxonomySource defaultTaxonomySource() {
+    TaxonomySource source;
+    for (const TaxonomyEntry& entry : DEFAULT_TAXONOMY) {
+        TaxonomySkill skill;
+        skill.name = entry.name;
+        skill.keyword = entry.keyword;
+        skill.tier = entry.tier;
+        skill.aliases = splitNames(entry.aliases);
+        source.skills.push_back(skill);
+    }
+    return source;
+}
+
+// Reads a taxonomy file. Blank lines and lines starting with '#' are skipped.
+//
+//   critical = 3                      points per critical skill (core, soft alike)
+//   min_job_points = 5                jobs worth fewer points always score 0
+//   match = words                     or substrings; see SkillMatchMode
+//   skill: machine learning | keyword critical | machine-learning, ml
+//
+// A skill line gives the name, then the groups it belongs to (keyword and at
+// most one of critical, core, soft), then optional comma-separated aliases.
+// Names are matched ignoring ASCII case, like the descriptions.
+inline bool parseTaxonomyFile(const string& path, TaxonomySource& source, string& error) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        error = "Could not open " + path;
+        return false;
+    }
+    source = TaxonomySource();
+    source.origin = path;
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        line = trimCopy(line);
+        if (line.empty() || line[0] == '#') continue;
+        const string where = path + ":" + to_string(lineNumber) + ": ";
+
+        if (line.compare(0, 6, "skill:") == 0) {
+            string fields[3];
+            size_t start = 6;
+            for (int f = 0; f < 3 && start != string::npos; ++f) {
+                size_t bar = (f < 2) ? line.find('|', start) : string::npos;
+                fields[f] = trimCopy(line.substr(start, bar == string::npos ? string::npos : bar - start));
+                start = (bar == string::npos) ? string::npos : bar + 1;
+            }
+            TaxonomySkill skill;
+            skill.name = lowerCopy(fields[0]);
+            if (skill.name.empty()) {
+                error = where + "skill without a name";
+                return false;
+            }
+            size_t pos = 0;
+            while (pos < fields[1].size()) {
+                size_t end = fields[1].find_first_of(" \t", pos);
+                if (end == string::npos) end = fields[1].size();
+                const string group = lowerCopy(fields[1].substr(pos, end - pos));
+                pos = end + 1;
+                if (group.empty()) continue;
+                SkillTier tier = TIER_KEYWORD;
+                if (group == "keyword") {
+                    skill.keyword = true;
+                    continue;
+                } else if (group == "critical") tier = TIER_CRITICAL;
+                else if (group == "core") tier = TIER_CORE;
+                else if (group == "soft") tier = TIER_SOFT;
+                else {
+                    error = where + "unknown group '" + group + "'";
+                    return false;
+                }
+                if (skill.tier != TIER_KEYWORD) {
+                    error = where + "'" + skill.name + "' is in more than one tier";
+                    return false;
+                }
+                skill.tier = tier;
+            }
+            skill.aliases = splitNames(fields[2]);
+            source.skills.push_back(skill);
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        const string key = lowerCopy(trimCopy(line.substr(0, equals)));
+        const string value = (equals == string::npos) ? "" : trimCopy(line.substr(equals + 1));
+        if (key == "match") {
+            if (!parseSkillMatchMode(lowerCopy(value), source.matchMode)) {
+                error = where + "match must be words or substrings";
+                return false;
+            }
+            continue;
+        }
+        char* end = nullptr;
+        const long number = strtol(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0') {
+            error = where + "expected 'skill: ...' or '<setting> = <number>'";
+            return false;
+        }
+        if (key == "critical") source.weights[0] = (int)number;
+        else if (key == "core") source.weights[1] = (int)number;
+        else if (key == "soft") source.weights[2] = (int)number;
+        else if (key == "min_job_points") source.minJobPoints = (int)number;
+        else {
+            error = where + "unknown setting '" + key + "'";
+            return false;
+        }
+        if (number < 0 || number > (long)MAX_TIER_WEIGHT * SKILL_MASK_BITS) {
+            error = where + "'" + key + "' is out of range";
+            return false;
+        }
+    }
+    return true;
+}
+
+// A checked taxonomy with its matcher and tier layout built; never changes
+class CompiledTaxonomy {
+private:
+    string origin;
+    SkillMatchMode mode;
+    SkillTokenizer tokenizer;       // SKILL_MATCH_WORDS
+    SkillMatcher matcher;           // SKILL_MATCH_SUBSTRINGS
+    TierLayout layout;
+    vector<string> keywordNames;    // by keyword bit
+    vector<string> tierNames;       // by packed tier bit
+    uint64_t fingerprint;
+
+    static int countTier(const TaxonomySource& source, SkillTier tier) {
+        int count = 0;
+        for (const TaxonomySkill& skill : source.skills) count += (skill.tier == tier) ? 1 : 0;
+        return count;
+    }
+
+public:
+    // `source` must have passed validateTaxonomy()
+    explicit CompiledTaxonomy(const TaxonomySource& source)
+        : origin(source.origin), mode(source.matchMode),
+          layout(countTier(source, TIER_CRITICAL), countTier(source, TIER_CORE), countTier(source, TIER_SOFT),
+                 source.weights[0], source.weights[1], source.weights[2], source.minJobPoints) {
+        int tierBits[3] = {0, 0, 0};
+        tierNames.resize(layout.counts[0] + layout.counts[1] + layout.counts[2]);
+        for (const TaxonomySkill& skill : source.skills) {
+            const int keywordBit = (int)keywordNames.size();
+            if (skill.keyword) keywordNames.push_back(skill.name);
+            int tierBit = -1;
+            if (skill.tier != TIER_KEYWORD) {
+                const int t = skill.tier - TIER_CRITICAL;
+                tierBit = tierBits[t]++;
+                tierNames[(t == 0 ? 0 : t == 1 ? layout.coreShift : layout.softShift) + tierBit] = skill.name;
+            }
+            // The name and every alias lead to the same bits
+            for (size_t p = 0; p <= skill.aliases.size(); ++p) {
+                const char* pattern = (p == 0) ? skill.name.c_str() : skill.aliases[p - 1].c_str();
+                if (mode == SKILL_MATCH_WORDS) {
+                    if (skill.keyword) tokenizer.addPattern(pattern, TIER_KEYWORD, keywordBit);
+                    if (tierBit >= 0) tokenizer.addPattern(pattern, skill.tier, tierBit);
+                } else {
+                    if (skill.keyword) matcher.addPattern(pattern, TIER_KEYWORD, keywordBit);
+                    if (tierBit >= 0) matcher.addPattern(pattern, skill.tier, tierBit);
+                }
+            }
+        }
+        if (mode == SKILL_MATCH_WORDS) tokenizer.build();
+        else matcher.build();
+
+        // Scores depend on the mode and weights too, so saved results must not outlive them
+        fingerprint = (mode == SKILL_MATCH_WORDS) ? tokenizer.getFingerprint() : matcher.getFingerprint();
+        const int settings[5] = {source.weights[0], source.weights[1], source.weights[2], source.minJobPoints, mode};
+        for (int value : settings) fingerprint = (fingerprint ^ (uint64_t)value) * 0x100000001B3ULL;
+    }
+
+    // Skill bits found in a description
+    SkillHits scan(const char* text, size_t length) const {
+        return mode == SKILL_MATCH_WORDS ? tokenizer.scan(text, length) : matcher.scan(text, length);
+    }
+
+    SkillHits scan(string_view text) const {
+        return scan(text.data(), text.size());
+    }
+
+    const string& getOrigin() const { return origin; }
+    SkillMatchMode getMatchMode() const { return mode; }
+    const TierLayout& getTierLayout() const { return layout; }
+    int getKeywordCount() const { return (int)keywordNames.size(); }
+    const string& keywordName(int bit) const { return keywordNames[bit]; }
+    const string& tierName(int bit) const { return tierNames[bit]; }
+
+    // Changes whenever the skills, their bits, the mode or the weights do
+    uint64_t getFingerprint() const { return fingerprint; }
+};
+
+inline bool validateTaxonomy(const TaxonomySource& source, string& error) {
+    int keywordCount = 0, weightedCount = 0;
+    vector<string> patterns;
+    for (const TaxonomySkill& skill : source.skills) {
+        if (!skill.keyword && skill.tier == TIER_KEYWORD) {
+            error = "'" + skill.name + "' belongs to no group";
+            return false;
+        }
+        keywordCount += skill.keyword ? 1 : 0;
+        weightedCount += (skill.tier != TIER_KEYWORD) ? 1 : 0;
+        patterns.push_back(skill.name);
+        patterns.insert(patterns.end(), skill.aliases.begin(), skill.aliases.end());
+    }
+    // Patterns are compared as the matcher sees them: in words mode
+    // "machine-learning" and "Machine Learning" are the same phrase
+    vector<pair<string, string>> keys;   // (key, pattern as written)
+    for (const string& pattern : patterns) {
+        if (source.matchMode == SKILL_MATCH_WORDS) {
+            const int words = SkillTokenizer::countWords(pattern.c_str());
+            if (words == 0 || words > MAX_SKILL_WORDS) {
+                error = "'" + pattern + "' must have between 1 and " + to_string(MAX_SKILL_WORDS) + " words";
+                return false;
+            }
+            keys.push_back(make_pair(SkillTokenizer::phraseKey(pattern.c_str()), pattern));
+        } else {
+            string key;
+            for (char c : pattern) key += (char)asciiLower((unsigned char)c);
+            keys.push_back(make_pair(key, pattern));
+        }
+    }
+    if (keywordCount > SKILL_MASK_BITS || weightedCount > SKILL_MASK_BITS) {
+        error = "at most " + to_string(SKILL_MASK_BITS) + " keyword and " + to_string(SKILL_MASK_BITS) +
+                " weighted skills fit a skill mask";
+        return false;
+    }
+    for (int w : source.weights) {
+        // A weight of 0 would leave that tier's skills scoring nothing
+        if (w < 1 || w > MAX_TIER_WEIGHT) {
+            error = "tier weights must be between 1 and " + to_string(MAX_TIER_WEIGHT);
+            return false;
+        }
+    }
+    if (source.minJobPoints < 1) {
+        // A job worth 0 points would make a 0/0 score
+        error = "min_job_points must be at least 1";
+        return false;
+    }
+    sort(keys.begin(), keys.end());
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if (keys[i].first == keys[i - 1].first) {
+            error = (keys[i].second == keys[i - 1].second)
+                  ? "'" + keys[i].second + "' names more than one skill"
+                  : "'" + keys[i - 1].second + "' and '" + keys[i].second + "' are the same pattern";
+            return false;
+        }
+    }
+    return true;
+}
+
+// The taxonomy every matcher uses. It is fixed the first time anything reads
+// it; a file has to be installed before that, at startup.
+inline const CompiledTaxonomy*& installedTaxonomy() {
+    static const CompiledTaxonomy* installed = nullptr;
+    return installed;
+}
+
+inline bool& taxonomyInUse() {
+    static bool inUse = false;
+    return inUse;
+}
+
+inline const CompiledTaxonomy& activeTaxonomy() {
+    static const CompiledTaxonomy& active = [] () -> const CompiledTaxonomy& {
+        taxonomyInUse() = true;
+        if (installedTaxonomy() == nullptr) installedTaxonomy() = new CompiledTaxonomy(defaultTaxonomySource());
+        return *installedTaxonomy();
+    }();
+    return active;
+}
+
+// Not thread-safe; call before any matching starts
+inline bool installTaxonomy(const TaxonomySource& source, string& error) {
+    if (taxonomyInUse()) {
+        error = "the skill taxonomy is already in use";
+        return false;
+    }
+    if (!validateTaxonomy(source, error)) return false;
+    delete installedTaxonomy();
+    installedTaxonomy() = new CompiledTaxonomy(source);
+    return true;
+}
+
+inline bool loadTaxonomyFile(const string& path, string& error) {
+    TaxonomySource source;
+    if (!parseTaxonomyFile(path, source, error)) return false;
+    if (!installTaxonomy(source, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+#endif
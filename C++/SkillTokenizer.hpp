@@ -0,0 +1,283 @@
+#ifndef SKILL_TOKENIZER_HPP
+#define SKILL_TOKENIZER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SkillVector.hpp"
+#include "SkillMatcher.hpp"
+using namespace std;
+
+// Word-level skill extraction. A description is split into words in one pass,
+// and at each word the longest phrase of up to MAX_SKILL_WORDS words that
+// names a skill is looked up in an open-addressing dictionary; its words are
+// then consumed. Unlike the substring automaton, "java" is not found inside
+// "javascript" nor "git" inside "digital", and the "engineer" of "ML Engineer"
+// is part of that skill rather than a second one. A word costs one hash probe
+// per phrase length tried, however many skills the taxonomy holds.
+//
+// Words are runs of ASCII letters and digits, '+', '#' and non-ASCII UTF-8
+// text, so "c++" and "c#" are words and "machine-learning" is the two words
+// "machine learning". Common UTF-8 spaces and punctuation separate words like
+// their ASCII counterparts (see skillSeparatorLength), so "Python’s" holds
+// the word "python". Patterns are split the same way; ASCII case is ignored.
+
+static const int MAX_SKILL_WORDS = 8;   // a power of two: the scan keeps a ring of words
+
+// Byte -> the byte as a word is hashed and compared (ASCII letters lowercased),
+// or 0 for a byte that separates words
+struct WordByteTable {
+    unsigned char fold[256];
+
+    constexpr WordByteTable() : fold() {
+        for (int c = 1; c < 256; ++c) {
+            bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                        c == '+' || c == '#' || c >= 0x80;
+            fold[c] = word ? (unsigned char)((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c) : 0;
+        }
+    }
+};
+
+static constexpr WordByteTable SKILL_WORD_BYTES{};
+
+// Length of the UTF-8 space or punctuation character at `p`, or 0 for one
+// that can be part of a word. Covers no-break space and guillemets, the whole
+// General Punctuation block U+2000-U+206F (spaces, dashes, curly quotes,
+// bullets, ellipsis), the ideographic space and stops and the byte order mark.
+inline int skillSeparatorLength(const unsigned char* p, size_t available) {
+    if (available >= 2 && p[0] == 0xC2) return (p[1] == 0xA0 || p[1] == 0xAB || p[1] == 0xBB) ? 2 : 0;
+    if (available < 3) return 0;
+    if (p[0] == 0xE2) return (p[1] == 0x80 || p[1] == 0x81) ? 3 : 0;
+    if (p[0] == 0xE3) return (p[1] == 0x80 && p[2] <= 0x82) ? 3 : 0;
+    if (p[0] == 0xEF) return (p[1] == 0xBB && p[2] == 0xBF) ? 3 : 0;
+    return 0;
+}
+
+class SkillTokenizer {
+private:
+    static const uint64_t PHRASE_SEED = 0x243F6A8885A308D3ULL;
+
+    struct Word {
+        const char* text;
+        int length;
+        uint64_t hash;
+    };
+
+    struct Phrase {
+        uint64_t hash;
+        string key;         // lowercase words joined by single spaces
+        int words;
+        SkillHits hits;
+        bool skill;         // a pattern ends here, not only a longer one's prefix
+        bool extends;       // a longer pattern starts with these words
+    };
+
+    // Open-addressing slot; the hash and length are copied here so a probe
+    // that misses never touches the phrase itself
+    struct Slot {
+        uint64_t hash;
+        int words;          // 0 when empty
+        int phrase;
+    };
+
+    vector<Phrase> phrases;
+    vector<Slot> slots;     // size a power of two
+    int longestPhrase;
+    uint64_t fingerprint;   // FNV-1a over every (phrase, tier, bit) added
+
+    static uint64_t extendHash(uint64_t phrase, uint64_t word) {
+        uint64_t h = (phrase ^ word) * 0x9E3779B97F4A7C15ULL;
+        return h ^ (h >> 32);
+    }
+
+    // Next word at or after `pos`; false at the end of the text. The per-byte
+    // hash is only a rotate and xor; extendHash mixes it properly per word.
+    // Only non-ASCII bytes are checked for UTF-8 separators.
+    static bool nextWord(const char* text, size_t length, size_t& pos, Word& word) {
+        // Locals, so the loops do not reload through the references
+        const unsigned char* bytes = (const unsigned char*)text;
+        const unsigned char* fold = SKILL_WORD_BYTES.fold;
+        size_t i = pos;
+        for (;;) {
+            while (i < length && fold[bytes[i]] == 0) i++;
+            if (i == length) {
+                pos = i;
+                return false;
+            }
+            const int separator = (bytes[i] >= 0x80) ? skillSeparatorLength(bytes + i, length - i) : 0;
+            if (separator == 0) break;
+            i += separator;
+        }
+        const size_t start = i;
+        uint64_t hash = 0;
+        unsigned char c;
+        while (i < length && (c = fold[bytes[i]]) != 0) {
+            if (c >= 0x80 && skillSeparatorLength(bytes + i, length - i) != 0) break;
+            hash = ((hash << 7) | (hash >> 57)) ^ c;
+            i++;
+        }
+        pos = i;
+        word.text = text + start;
+        word.length = (int)(i - start);
+        word.hash = hash;
+        return true;
+    }
+
+    // The key spells the given words, ignoring case
+    static bool sameWords(const string& key, const Word* ring, int head, int count) {
+        size_t k = 0;
+        for (int n = 0; n < count; ++n) {
+            const Word& w = ring[(head + n) & (MAX_SKILL_WORDS - 1)];
+            if (n > 0 && (k >= key.size() || key[k++] != ' ')) return false;
+            if (key.size() - k < (size_t)w.length) return false;
+            for (int i = 0; i < w.length; ++i)
+                if ((unsigned char)key[k + i] != SKILL_WORD_BYTES.fold[(unsigned char)w.text[i]]) return false;
+            k += w.length;
+        }
+        return k == key.size();
+    }
+
+    const Phrase* find(uint64_t hash, const Word* ring, int head, int count) const {
+        const size_t mask = slots.size() - 1;
+        for (size_t s = hash & mask;; s = (s + 1) & mask) {
+            const Slot& slot = slots[s];
+            if (slot.words == 0) return nullptr;
+            if (slot.hash == hash && slot.words == count && sameWords(phrases[slot.phrase].key, ring, head, count))
+                return &phrases[slot.phrase];
+        }
+    }
+
+    void rehash(size_t capacity) {
+        slots.assign(capacity, Slot{0, 0, 0});
+        for (int p = 0; p < (int)phrases.size(); ++p) {
+            size_t s = phrases[p].hash & (capacity - 1);
+            while (slots[s].words != 0) s = (s + 1) & (capacity - 1);
+            slots[s] = Slot{phrases[p].hash, phrases[p].words, p};
+        }
+    }
+
+    // Looks the phrase up in the dictionary, which is kept at most half full
+    // while patterns are added
+    Phrase& findOrAdd(uint64_t hash, const string& key, int words) {
+        if (slots.empty()) rehash(16);
+        const size_t mask = slots.size() - 1;
+        size_t s = hash & mask;
+        for (; slots[s].words != 0; s = (s + 1) & mask)
+            if (slots[s].hash == hash && phrases[slots[s].phrase].key == key) return phrases[slots[s].phrase];
+        phrases.push_back(Phrase{hash, key, words, SkillHits(), false, false});
+        slots[s] = Slot{hash, words, (int)phrases.size() - 1};
+        if (phrases.size() * 2 > slots.size()) rehash(slots.size() * 2);
+        return phrases.back();
+    }
+
+public:
+    SkillTokenizer() : longestPhrase(0), fingerprint(0xCBF29CE484222325ULL) {}
+
+    // Words in a pattern, as the scan would split it
+    static int countWords(const char* pattern) {
+        size_t pos = 0, length = char_traits<char>::length(pattern);
+        Word word;
+        int count = 0;
+        while (nextWord(pattern, length, pos, word)) count++;
+        return count;
+    }
+
+    // Lowercase words of a pattern joined by single spaces; patterns with the
+    // same key are the same phrase to the scan
+    static string phraseKey(const char* pattern) {
+        size_t pos = 0, length = char_traits<char>::length(pattern);
+        Word word;
+        string key;
+        while (nextWord(pattern, length, pos, word)) {
+            if (!key.empty()) key += ' ';
+            for (int i = 0; i < word.length; ++i) key += (char)SKILL_WORD_BYTES.fold[(unsigned char)word.text[i]];
+        }
+        return key;
+    }
+
+    // The pattern must have between 1 and MAX_SKILL_WORDS words
+    void addPattern(const char* pattern, SkillTier tier, int bit) {
+        const size_t length = char_traits<char>::length(pattern);
+        size_t pos = 0;
+        Word word;
+        string key;
+        uint64_t hash = PHRASE_SEED;
+        int words = 0;
+        vector<int> prefixes;
+        while (nextWord(pattern, length, pos, word)) {
+            if (words > 0) key += ' ';
+            for (int i = 0; i < word.length; ++i) key += (char)SKILL_WORD_BYTES.fold[(unsigned char)word.text[i]];
+            hash = extendHash(hash, word.hash);
+            words++;
+            prefixes.push_back((int)(&findOrAdd(hash, key, words) - phrases.data()));
+        }
+        if (words == 0) return;
+        for (size_t i = 0; i + 1 < prefixes.size(); ++i) phrases[prefixes[i]].extends = true;
+
+        Phrase& phrase = phrases[prefixes.back()];
+        phrase.skill = true;
+        SkillMask flag = SkillMask(1) << bit;
+        switch (tier) {
+            case TIER_KEYWORD:  phrase.hits.keyword |= flag; break;
+            case TIER_CRITICAL: phrase.hits.critical |= flag; break;
+            case TIER_CORE:     phrase.hits.core |= flag; break;
+            case TIER_SOFT:     phrase.hits.soft |= flag; break;
+        }
+        if (words > longestPhrase) longestPhrase = words;
+
+        for (char c : key) fingerprint = (fingerprint ^ (unsigned char)c) * 0x100000001B3ULL;
+        fingerprint = (fingerprint ^ 0xFF) * 0x100000001B3ULL;
+        fingerprint = (fingerprint ^ (uint64_t)(tier * 64 + bit)) * 0x100000001B3ULL;
+    }
+
+    // Sizes the dictionary to at most half full
+    void build() {
+        size_t capacity = 16;
+        while (capacity < phrases.size() * 2) capacity *= 2;
+        rehash(capacity);
+    }
+
+    SkillHits scan(const char* text, size_t length) const {
+        SkillHits hits;
+        if (longestPhrase == 0) return hits;
+        Word ring[MAX_SKILL_WORDS];
+        int head = 0, count = 0;
+        size_t pos = 0;
+        for (;;) {
+            while (count < longestPhrase && nextWord(text, length, pos, ring[(head + count) & (MAX_SKILL_WORDS - 1)]))
+                count++;
+            if (count == 0) break;
+
+            // Longest skill starting at the head word
+            const Phrase* best = nullptr;
+            int take = 1;
+            uint64_t hash = PHRASE_SEED;
+            for (int n = 1; n <= count; ++n) {
+                hash = extendHash(hash, ring[(head + n - 1) & (MAX_SKILL_WORDS - 1)].hash);
+                const Phrase* phrase = find(hash, ring, head, n);
+                if (phrase == nullptr) break;
+                if (phrase->skill) {
+                    best = phrase;
+                    take = n;
+                }
+                if (!phrase->extends) break;
+            }
+            if (best != nullptr) hits.merge(best->hits);
+            head = (head + take) & (MAX_SKILL_WORDS - 1);
+            count -= take;
+        }
+        return hits;
+    }
+
+    SkillHits scan(string_view text) const {
+        return scan(text.data(), text.size());
+    }
+
+    int getPhraseCount() const { return (int)phrases.size(); }
+
+    // Changes whenever the skill taxonomy does; stored with saved skill masks
+    uint64_t getFingerprint() const { return fingerprint; }
+};
+
+#endif
@@ -0,0 +1,218 @@
+#ifndef SKILL_VECTOR_HPP
+#define SKILL_VECTOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+// Packed skill vector: bit i is set when skill i of the taxonomy was found.
+typedef uint64_t SkillMask;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SKILL_VECTOR_X86 1
+#include <immintrin.h>
+#endif
+
+inline int popcount64(SkillMask m) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(m);
+#else
+    m = m - ((m >> 1) & 0x5555555555555555ULL);
+    m = (m & 0x3333333333333333ULL) + ((m >> 2) & 0x3333333333333333ULL);
+    m = (m + (m >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((m * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Index of the lowest set bit; m must be non-zero
+inline int countTrailingZeros(SkillMask m) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(m);
+#else
+    int n = 0;
+    while (!(m & 1)) { m >>= 1; n++; }
+    return n;
+#endif
+}
+
+// Scores one resume against a block of jobs: out[i] = popcount(resume & jobs[i]).
+typedef void (*ScoreBlockFn)(SkillMask resume, const SkillMask* jobs, int* out, size_t count);
+
+inline void scoreBlockScalar(SkillMask resume, const SkillMask* jobs, int* out, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = popcount64(resume & jobs[i]);
+}
+
+// Points of a packed mask holding three disjoint groups of bits, each set bit
+// worth the weight of its group. Weights are non-negative and small enough
+// that 64 bits at the largest weight fit an int.
+struct BitWeights {
+    SkillMask group[3];
+    int weight[3];
+};
+
+inline int weighBits(const BitWeights& w, SkillMask m) {
+    return w.weight[0] * popcount64(m & w.group[0]) + w.weight[1] * popcount64(m & w.group[1])
+         + w.weight[2] * popcount64(m & w.group[2]);
+}
+
+// Weighted variant: out[i] = weighBits(w, resume & jobs[i]).
+typedef void (*WeightBlockFn)(SkillMask resume, const SkillMask* jobs, int* out, size_t count,
+                              const BitWeights& w);
+
+inline void weightBlockScalar(SkillMask resume, const SkillMask* jobs, int* out, size_t count,
+                              const BitWeights& w) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = weighBits(w, resume & jobs[i]);
+}
+
+#ifdef SKILL_VECTOR_X86
+
+__attribute__((target("popcnt")))
+inline void scoreBlockPopcnt(SkillMask resume, const SkillMask* jobs, int* out, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = (int)__builtin_popcountll(resume & jobs[i]);
+}
+
+// AVX2 has no vector popcount, so count nibbles with a shuffle table and sum bytes with SAD.
+__attribute__((target("avx2,popcnt")))
+inline void scoreBlockAVX2(SkillMask resume, const SkillMask* jobs, int* out, size_t count) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    const __m256i r = _mm256_set1_epi64x((long long)resume);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_and_si256(r, _mm256_loadu_si256((const __m256i*)(jobs + i)));
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low4));
+        __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+        __m256i sums = _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+        // Each 64-bit lane now holds its count; pack the low dwords into four ints.
+        __m256i packed = _mm256_permutevar8x32_epi32(sums, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_castsi256_si128(packed));
+    }
+    for (; i < count; ++i)
+        out[i] = (int)__builtin_popcountll(resume & jobs[i]);
+}
+
+__attribute__((target("popcnt")))
+inline void weightBlockPopcnt(SkillMask resume, const SkillMask* jobs, int* out, size_t count,
+                              const BitWeights& w) {
+    for (size_t i = 0; i < count; ++i) {
+        SkillMask v = resume & jobs[i];
+        out[i] = w.weight[0] * (int)__builtin_popcountll(v & w.group[0])
+               + w.weight[1] * (int)__builtin_popcountll(v & w.group[1])
+               + w.weight[2] * (int)__builtin_popcountll(v & w.group[2]);
+    }
+}
+
+// Set bits of each 64-bit lane of v, by the nibble table of scoreBlockAVX2
+__attribute__((target("avx2")))
+inline __m256i laneCountsAVX2(__m256i v, __m256i lookup, __m256i low4) {
+    __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low4));
+    __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+// One SAD per group, then each lane count times its weight
+__attribute__((target("avx2,popcnt")))
+inline void weightBlockAVX2(SkillMask resume, const SkillMask* jobs, int* out, size_t count,
+                            const BitWeights& w) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    const __m256i r = _mm256_set1_epi64x((long long)resume);
+    __m256i groups[3], weights[3];
+    for (int g = 0; g < 3; ++g) {
+        groups[g] = _mm256_set1_epi64x((long long)w.group[g]);
+        weights[g] = _mm256_set1_epi64x(w.weight[g]);
+    }
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_and_si256(r, _mm256_loadu_si256((const __m256i*)(jobs + i)));
+        __m256i sums = _mm256_setzero_si256();
+        for (int g = 0; g < 3; ++g)
+            sums = _mm256_add_epi64(sums, _mm256_mul_epu32(laneCountsAVX2(_mm256_and_si256(v, groups[g]), lookup, low4),
+                                                           weights[g]));
+        __m256i packed = _mm256_permutevar8x32_epi32(sums, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_castsi256_si128(packed));
+    }
+    weightBlockPopcnt(resume, jobs + i, out + i, count - i, w);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+inline void weightBlockAVX512(SkillMask resume, const SkillMask* jobs, int* out, size_t count,
+                              const BitWeights& w) {
+    const __m512i r = _mm512_set1_epi64((long long)resume);
+    __m512i groups[3], weights[3];
+    for (int g = 0; g < 3; ++g) {
+        groups[g] = _mm512_set1_epi64((long long)w.group[g]);
+        weights[g] = _mm512_set1_epi64(w.weight[g]);
+    }
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i v = _mm512_and_si512(r, _mm512_loadu_si512((const void*)(jobs + i)));
+        __m512i sum = _mm512_setzero_si512();
+        for (int g = 0; g < 3; ++g)
+            sum = _mm512_add_epi64(sum, _mm512_maskz_mul_epu32((__mmask8)0xFF,
+                                                               _mm512_popcnt_epi64(_mm512_and_si512(v, groups[g])), weights[g]));
+        // Zero-masked forms as in scoreBlockAVX512, so no undefined operand is involved
+        _mm256_storeu_si256((__m256i*)(out + i), _mm512_maskz_cvtepi64_epi32((__mmask8)0xFF, sum));
+    }
+    weightBlockPopcnt(resume, jobs + i, out + i, count - i, w);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+inline void scoreBlockAVX512(SkillMask resume, const SkillMask* jobs, int* out, size_t count) {
+    const __m512i r = _mm512_set1_epi64((long long)resume);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i v = _mm512_and_si512(r, _mm512_loadu_si512((const void*)(jobs + i)));
+        // Zero-masked with every lane selected: the same vpmovqd, but with no
+        // undefined source operand for GCC's -Wmaybe-uninitialized to flag
+        _mm256_storeu_si256((__m256i*)(out + i), _mm512_maskz_cvtepi64_epi32((__mmask8)0xFF, _mm512_popcnt_epi64(v)));
+    }
+    for (; i < count; ++i)
+        out[i] = (int)__builtin_popcountll(resume & jobs[i]);
+}
+
+#endif
+
+// Picks the widest kernel the running CPU supports, once per process.
+inline ScoreBlockFn selectScoreBlock() {
+#ifdef SKILL_VECTOR_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+        return scoreBlockAVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return scoreBlockAVX2;
+    if (__builtin_cpu_supports("popcnt"))
+        return scoreBlockPopcnt;
+#endif
+    return scoreBlockScalar;
+}
+
+inline void scoreBlock(SkillMask resume, const SkillMask* jobs, int* out, size_t count) {
+    static const ScoreBlockFn kernel = selectScoreBlock();
+    kernel(resume, jobs, out, count);
+}
+
+inline WeightBlockFn selectWeightBlock() {
+#ifdef SKILL_VECTOR_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+        return weightBlockAVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return weightBlockAVX2;
+    if (__builtin_cpu_supports("popcnt"))
+        return weightBlockPopcnt;
+#endif
+    return weightBlockScalar;
+}
+
+inline void weightBlock(SkillMask resume, const SkillMask* jobs, int* out, size_t count,
+                        const BitWeights& w) {
+    static const WeightBlockFn kernel = selectWeightBlock();
+    kernel(resume, jobs, out, count, w);
+}
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include "SkillTaxonomy.hpp"
+#include "TextStore.hpp"
+#include "LinkedListNodes.hpp"
+#include "Metrics.hpp"
+using namespace std;
+
+// Binary snapshot of both lists after preprocessing: IDs, skill masks,
+// descriptions and the last match results. The file is mapped as is at
+// startup; descriptions stay views into the mapping and no text is scanned.
+// It is ignored when either CSV's size or mtime, the skill taxonomy, the
+// format version or the byte order differs from what it was written with.
+//
+// Layout, every section 8-byte aligned:
+//   SnapshotHeader
+//   SnapshotRecord[jobCount], SnapshotRecord[resumeCount]
+//   SnapshotJobResult[jobCount], SnapshotResumeResult[resumeCount]
+//   text: IDs and descriptions back to back
+
+static const char SNAPSHOT_MAGIC[8] = {'J', 'M', 'S', 'N', 'A', 'P', '\r', '\n'};
+static const uint32_t SNAPSHOT_VERSION = 4;   // 2: descriptions keep their original case
+                                              // 3: UTF-8 punctuation separates words
+                                              // 4: source mtimes in nanoseconds
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// Which matching run produced the stored results
+enum SnapshotResults {
+    SNAPSHOT_NO_RESULTS = 0,
+    SNAPSHOT_KEYWORD_RESULTS = 1,
+    SNAPSHOT_WEIGHTED_RESULTS = 2
+};
+
+struct SourceStamp {
+    uint64_t size;
+    int64_t mtime;             // nanoseconds since the epoch
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t skillFingerprint;
+    SourceStamp jobSource;
+    SourceStamp resumeSource;
+    uint32_t jobCount;
+    uint32_t resumeCount;
+    uint32_t results;          // SnapshotResults
+    uint32_t reserved;
+    uint64_t jobRecordsOffset;
+    uint64_t resumeRecordsOffset;
+    uint64_t jobResultsOffset;
+    uint64_t resumeResultsOffset;
+    uint64_t textOffset;
+    uint64_t textBytes;
+    uint64_t fileBytes;
+};
+
+struct SnapshotRecord {
+    uint64_t idOffset;         // into the text section
+    uint64_t descriptionOffset;
+    uint32_t idLength;
+    uint32_t descriptionLength;
+    uint64_t skillMask;
+    uint64_t criticalMask;
+    uint64_t coreMask;
+    uint64_t softMask;
+};
+
+struct SnapshotJobResult {
+    int32_t totalMatches;
+    int32_t reserved;
+    double totalScore;
+};
+
+struct SnapshotResumeResult {
+    int32_t bestJob;           // job record index, -1 when unmatched
+    int32_t outcome;           // MatchOutcome
+    double bestScore;
+};
+
+inline bool stampSource(const string& path, SourceStamp& stamp) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    stamp.size = (uint64_t)info.st_size;
+    // Nanoseconds where the platform has them, so a same-size edit within the
+    // second the snapshot was saved in still changes the stamp
+#if defined(__APPLE__)
+    stamp.mtime = (int64_t)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    stamp.mtime = (int64_t)info.st_mtime * 1000000000;
+#else
+    stamp.mtime = (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+inline uint64_t alignSnapshot(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+// True when [offset, offset + length) lies within the first `limit` bytes;
+// checked without forming the sum, which could wrap
+inline bool snapshotSpanFits(uint64_t offset, uint64_t length, uint64_t limit) {
+    return offset <= limit && length <= limit - offset;
+}
+
+// Moves the finished temporary file over the old snapshot. POSIX rename()
+// replaces it atomically, even while the old file is mapped; Windows cannot
+// replace a mapped file, so there loadSnapshot reads it instead.
+inline bool replaceSnapshot(const string& temporary, const string& path) {
+#ifdef _WIN32
+    return MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+}
+
+template <typename Node>
+inline SnapshotRecord makeSnapshotRecord(const Node* node, string& text) {
+    SnapshotRecord record;
+    record.idOffset = text.size();
+    record.idLength = (uint32_t)node->id.size();
+    text.append(node->id);
+    record.descriptionOffset = text.size();
+    record.descriptionLength = (uint32_t)node->description.size();
+    text.append(node->description.data(), node->description.size());
+    record.skillMask = node->skillMask;
+    record.criticalMask = node->criticalMask;
+    record.coreMask = node->coreMask;
+    record.softMask = node->softMask;
+    return record;
+}
+
+template <typename Node>
+inline void restoreSnapshotRecord(Node* node, const SnapshotRecord& record) {
+    node->skillMask = record.skillMask;
+    node->criticalMask = record.criticalMask;
+    node->coreMask = record.coreMask;
+    node->softMask = record.softMask;
+    node->skillsExtracted = true;
+}
+
+// Writes the snapshot to a temporary file and moves it into place, so a
+// crash never leaves a half-written snapshot behind. Only lists whose skills
+// have all been extracted can be saved. When the old snapshot cannot be
+// replaced it is kept, and the failure is reported.
+inline bool saveSnapshot(const string& path, const string& jobCsv, const string& resumeCsv,
+                         const JobLinkedList& jobs, const ResumeLinkedList& resumes,
+                         SnapshotResults results) {
+    ScopedPhase phase("snapshot.save");
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.skillFingerprint = activeTaxonomy().getFingerprint();
+    if (!stampSource(jobCsv, header.jobSource) || !stampSource(resumeCsv, header.resumeSource)) return false;
+
+    const JobColumns& jobCols = jobs.getColumns();
+    const ResumeColumns& resumeCols = resumes.getColumns();
+    header.jobCount = (uint32_t)jobCols.size();
+    header.resumeCount = (uint32_t)resumeCols.size();
+    header.results = results;
+
+    string text;
+    vector<SnapshotRecord> records;
+    records.reserve(header.jobCount + header.resumeCount);
+    for (JobNode* job : jobCols) {
+        if (!job->skillsExtracted) return false;
+        records.push_back(makeSnapshotRecord(job, text));
+    }
+    for (ResumeNode* resume : resumeCols) {
+        if (!resume->skillsExtracted) return false;
+        records.push_back(makeSnapshotRecord(resume, text));
+    }
+
+    vector<SnapshotJobResult> jobResults(header.jobCount);
+    for (int j = 0; j < jobCols.size(); ++j) {
+        jobResults[j].totalMatches = jobCols.totalMatches[j];
+        jobResults[j].reserved = 0;
+        jobResults[j].totalScore = jobCols.totalScore[j];
+    }
+    vector<SnapshotResumeResult> resumeResults(header.resumeCount);
+    for (int r = 0; r < resumeCols.size(); ++r) {
+        resumeResults[r].bestJob = resumeCols.bestJob[r];
+        resumeResults[r].outcome = resumeCols.node(r)->matchOutcome;
+        resumeResults[r].bestScore = resumeCols.node(r)->bestMatchScore;
+    }
+
+    header.jobRecordsOffset = alignSnapshot(sizeof(SnapshotHeader));
+    header.resumeRecordsOffset = header.jobRecordsOffset + (uint64_t)header.jobCount * sizeof(SnapshotRecord);
+    header.jobResultsOffset = header.resumeRecordsOffset + (uint64_t)header.resumeCount * sizeof(SnapshotRecord);
+    header.resumeResultsOffset = header.jobResultsOffset + (uint64_t)header.jobCount * sizeof(SnapshotJobResult);
+    header.textOffset = alignSnapshot(header.resumeResultsOffset + (uint64_t)header.resumeCount * sizeof(SnapshotResumeResult));
+    header.textBytes = text.size();
+    header.fileBytes = header.textOffset + header.textBytes;
+
+    string temporary = path + ".tmp";
+    FILE* out = fopen(temporary.c_str(), "wb");
+    if (out == nullptr) {
+        cerr << "Warning: could not write " << temporary << "; snapshot not saved" << endl;
+        return false;
+    }
+    static const char padding[8] = {0};
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1
+           && fwrite(padding, 1, header.jobRecordsOffset - sizeof(header), out) == header.jobRecordsOffset - sizeof(header)
+           && fwrite(records.data(), sizeof(SnapshotRecord), records.size(), out) == records.size()
+           && fwrite(jobResults.data(), sizeof(SnapshotJobResult), jobResults.size(), out) == jobResults.size()
+           && fwrite(resumeResults.data(), sizeof(SnapshotResumeResult), resumeResults.size(), out) == resumeResults.size();
+    uint64_t written = header.resumeResultsOffset + (uint64_t)header.resumeCount * sizeof(SnapshotResumeResult);
+    ok = ok && fwrite(padding, 1, header.textOffset - written, out) == header.textOffset - written
+            && fwrite(text.data(), 1, text.size(), out) == text.size();
+    ok = (fclose(out) == 0) && ok;
+    if (!ok) {
+        remove(temporary.c_str());
+        cerr << "Warning: could not write " << temporary << "; snapshot not saved" << endl;
+        return false;
+    }
+    if (!replaceSnapshot(temporary, path)) {
+        remove(temporary.c_str());
+        cerr << "Warning: could not replace " << path << "; keeping the previous snapshot" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Checks the header and every record's bounds before anything is loaded
+inline bool validateSnapshot(const MappedFile& file, const SourceStamp& jobSource, const SourceStamp& resumeSource) {
+    if (file.size() < sizeof(SnapshotHeader)) return false;
+    SnapshotHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != SNAPSHOT_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER) return false;
+    if (header.skillFingerprint != activeTaxonomy().getFingerprint()) return false;
+    if (header.results > SNAPSHOT_WEIGHTED_RESULTS) return false;
+    if (header.jobSource.size != jobSource.size || header.jobSource.mtime != jobSource.mtime) return false;
+    if (header.resumeSource.size != resumeSource.size || header.resumeSource.mtime != resumeSource.mtime) return false;
+    if (header.fileBytes != file.size() || !snapshotSpanFits(header.textOffset, header.textBytes, header.fileBytes)
+        || header.textOffset + header.textBytes != header.fileBytes)
+        return false;
+
+    // Every section must fit before the text; each offset is checked before
+    // the next one is computed from it. Section sizes are counts below 2^32
+    // times a small struct size, so they cannot overflow.
+    const uint64_t records = (uint64_t)header.jobCount + header.resumeCount;
+    const uint64_t jobRecordBytes = (uint64_t)header.jobCount * sizeof(SnapshotRecord);
+    const uint64_t resumeRecordBytes = (uint64_t)header.resumeCount * sizeof(SnapshotRecord);
+    const uint64_t jobResultBytes = (uint64_t)header.jobCount * sizeof(SnapshotJobResult);
+    const uint64_t resumeResultBytes = (uint64_t)header.resumeCount * sizeof(SnapshotResumeResult);
+    if (header.jobRecordsOffset < sizeof(SnapshotHeader) || header.jobRecordsOffset % 8 != 0
+        || !snapshotSpanFits(header.jobRecordsOffset, jobRecordBytes, header.textOffset)
+        || header.resumeRecordsOffset != header.jobRecordsOffset + jobRecordBytes
+        || !snapshotSpanFits(header.resumeRecordsOffset, resumeRecordBytes, header.textOffset)
+        || header.jobResultsOffset != header.resumeRecordsOffset + resumeRecordBytes
+        || !snapshotSpanFits(header.jobResultsOffset, jobResultBytes, header.textOffset)
+        || header.resumeResultsOffset != header.jobResultsOffset + jobResultBytes
+        || !snapshotSpanFits(header.resumeResultsOffset, resumeResultBytes, header.textOffset))
+        return false;
+
+    const SnapshotRecord* record = reinterpret_cast<const SnapshotRecord*>(file.data() + header.jobRecordsOffset);
+    for (uint64_t i = 0; i < records; ++i) {
+        if (!snapshotSpanFits(record[i].idOffset, record[i].idLength, header.textBytes)) return false;
+        if (!snapshotSpanFits(record[i].descriptionOffset, record[i].descriptionLength, header.textBytes)) return false;
+    }
+    const SnapshotResumeResult* result = reinterpret_cast<const SnapshotResumeResult*>(file.data() + header.resumeResultsOffset);
+    for (uint32_t r = 0; r < header.resumeCount; ++r) {
+        if (result[r].bestJob < -1 || result[r].bestJob >= (int32_t)header.jobCount) return false;
+        if (result[r].outcome < MATCH_PENDING || result[r].outcome > MATCH_BELOW_THRESHOLD) return false;
+    }
+    return true;
+}
+
+// Fills two empty lists from a valid snapshot; returns false, leaving the
+// lists untouched, when there is none and the CSVs have to be parsed.
+inline bool loadSnapshot(const string& path, const string& jobCsv, const string& resumeCsv,
+                         JobLinkedList& jobs, ResumeLinkedList& resumes, SnapshotResults& results) {
+    ScopedPhase phase("snapshot.load");
+    SourceStamp jobSource, resumeSource;
+    if (!stampSource(jobCsv, jobSource) || !stampSource(resumeCsv, resumeSource)) return false;
+    shared_ptr<MappedFile> file = make_shared<MappedFile>();
+#ifdef _WIN32
+    const bool opened = file->read(path);   // not mapped, so saveSnapshot can replace it
+#else
+    const bool opened = file->open(path);
+#endif
+    if (!opened || !validateSnapshot(*file, jobSource, resumeSource)) return false;
+
+    // Both lists keep the one mapping alive, so their descriptions live as
+    // long as they do; only the job list counts its memory
+    jobs.getTextArena().addFile(file, true);
+    resumes.getTextArena().addFile(file, false);
+
+    SnapshotHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    results = (SnapshotResults)header.results;
+
+    const SnapshotRecord* jobRecords = reinterpret_cast<const SnapshotRecord*>(file->data() + header.jobRecordsOffset);
+    const char* jobText = file->data() + header.textOffset;
+    for (uint32_t j = 0; j < header.jobCount; ++j) {
+        const SnapshotRecord& record = jobRecords[j];
+        JobNode* job = jobs.addJobAtEnd(string(jobText + record.idOffset, record.idLength),
+                                        string_view(jobText + record.descriptionOffset, record.descriptionLength));
+        restoreSnapshotRecord(job, record);
+    }
+
+    const SnapshotRecord* resumeRecords = reinterpret_cast<const SnapshotRecord*>(file->data() + header.resumeRecordsOffset);
+    const char* resumeText = file->data() + header.textOffset;
+    for (uint32_t r = 0; r < header.resumeCount; ++r) {
+        const SnapshotRecord& record = resumeRecords[r];
+        ResumeNode* resume = resumes.addResume(string(resumeText + record.idOffset, record.idLength),
+                                               string_view(resumeText + record.descriptionOffset, record.descriptionLength));
+        restoreSnapshotRecord(resume, record);
+    }
+
+    JobColumns& jobCols = jobs.getColumns();
+    ResumeColumns& resumeCols = resumes.getColumns();
+    for (int j = 0; j < jobCols.size(); ++j) jobCols.syncSkills(j);
+    for (int r = 0; r < resumeCols.size(); ++r) resumeCols.syncSkills(r);
+    if (results == SNAPSHOT_NO_RESULTS) return true;
+    jobs.markAllMatched();
+    resumes.markAllMatched();
+
+    const SnapshotJobResult* jobResults = reinterpret_cast<const SnapshotJobResult*>(file->data() + header.jobResultsOffset);
+    for (int j = 0; j < jobCols.size(); ++j) {
+        jobCols.totalMatches[j] = jobResults[j].totalMatches;
+        jobCols.totalScore[j] = jobResults[j].totalScore;
+    }
+    jobCols.flushStats();
+
+    const SnapshotResumeResult* resumeResults = reinterpret_cast<const SnapshotResumeResult*>(file->data() + header.resumeResultsOffset);
+    resumeCols.resetTopMatches(1);
+    for (int r = 0; r < resumeCols.size(); ++r) {
+        const SnapshotResumeResult& result = resumeResults[r];
+        ResumeNode* resume = resumeCols.node(r);
+        if (result.outcome == MATCH_FOUND && result.bestJob >= 0) {
+            resume->setBestMatch(jobCols.node(result.bestJob), result.bestScore);
+        } else {
+            resume->clearBestMatch((MatchOutcome)result.outcome);
+        }
+        resumeCols.bestJob[r] = resume->bestJob ? result.bestJob : -1;
+        resumeCols.bestScore[r] = resume->bestMatchScore;
+        double score = resume->bestMatchScore;
+        resumeCols.setTopMatches(r, &resumeCols.bestJob[r], &score, resume->bestJob ? 1 : 0);
+    }
+    return true;
+}
+
+#endif
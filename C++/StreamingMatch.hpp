@@ -0,0 +1,117 @@
+#ifndef STREAMING_MATCH_HPP
+#define STREAMING_MATCH_HPP
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "LinkedListNodes.hpp"
+#include "MatchingAlgorithm.hpp"
+#include "CsvParser.hpp"
+#include "Metrics.hpp"
+using namespace std;
+
+struct StreamSummary {
+    int resumes = 0;
+    int skipped = 0;
+    int batches = 0;
+    double seconds = 0.0;
+    vector<int> jobMatches;     // per job column: streamed resumes it is the best match of
+    vector<double> jobScores;   // and their scores, added up in file order
+};
+
+// Matches a resume CSV of any size against jobs already in memory. Jobs are
+// prepared once; resumes are read through a fixed buffer, gathered into
+// batches of `batchSize`, matched, written to `out` as
+// "ResumeID,BestJobID,Score" and freed before the next batch, so memory
+// depends on the batch size rather than on the file. Job stats are added up
+// batch by batch in file order into the summary, where they end up identical
+// to an in-memory run's; the job list's own stats and rankings, which belong
+// to its loaded resumes, are left alone.
+// IDs follow the loader: R001, R002, ... counting only accepted records.
+template <typename Algorithm>
+inline bool streamMatchResumes(const string& resumeCsv, JobLinkedList& jobs, Algorithm& algorithm,
+                               ostream& out, int batchSize, StreamSummary& summary) {
+    CsvStreamReader reader;
+    if (!reader.open(resumeCsv)) {
+        cerr << "Error: Could not open " << resumeCsv << endl;
+        return false;
+    }
+    if (batchSize < 1) batchSize = 1;
+
+    ScopedPhase phase("stream");
+    Stopwatch watch;
+    algorithm.prepareJobs(jobs);
+    const JobColumns& jobCols = jobs.getColumns();
+
+    out << "ResumeID,BestJobID,Score\n";
+    summary = StreamSummary();
+    summary.jobMatches.assign(jobCols.size(), 0);
+    summary.jobScores.assign(jobCols.size(), 0.0);
+
+    string_view record;
+    reader.next(record);   // header row
+    bool more = true;
+    while (more) {
+        ResumeLinkedList batch;
+        while (batch.getSize() < batchSize && (more = reader.next(record))) {
+            string_view trimmed = trim(record);
+            if (trimmed.empty()) continue;
+            if (extract_skills(trimmed).empty()) {
+                summary.skipped++;
+                continue;
+            }
+            batch.addResume(makeRecordId('R', summary.resumes + 1), trimmed);
+            summary.resumes++;
+        }
+        if (batch.getSize() == 0) break;
+
+        algorithm.matchResumes(batch, jobCols);
+        const ResumeColumns& resumeCols = batch.getColumns();
+        for (int r = 0; r < resumeCols.size(); ++r) {
+            const ResumeNode* resume = resumeCols.node(r);
+            out << resume->id << ',' << resume->getBestJobId() << ',' << resume->bestMatchScore << '\n';
+            const int job = resumeCols.bestJob[r];
+            if (job < 0) continue;
+            summary.jobMatches[job]++;
+            summary.jobScores[job] += resumeCols.bestScore[r];
+        }
+        summary.batches++;
+    }
+
+    out.flush();
+    summary.seconds = watch.elapsed();
+    return (bool)out;
+}
+
+// Average streamed score of a job, 0 when no streamed resume matched it
+inline double streamedAverage(const StreamSummary& summary, int job) {
+    return summary.jobMatches[job] > 0 ? summary.jobScores[job] / summary.jobMatches[job] : 0.0;
+}
+
+// The `count` jobs most streamed resumes matched, then by total score, then
+// by column index
+inline void displayStreamTopJobs(const JobColumns& jobCols, const StreamSummary& summary, int count) {
+    vector<int> order;
+    for (int j = 0; j < (int)summary.jobMatches.size(); ++j)
+        if (summary.jobMatches[j] > 0) order.push_back(j);
+    if (count > (int)order.size()) count = (int)order.size();
+    partial_sort(order.begin(), order.begin() + count, order.end(), [&](int a, int b) {
+        if (summary.jobMatches[a] != summary.jobMatches[b]) return summary.jobMatches[a] > summary.jobMatches[b];
+        if (summary.jobScores[a] != summary.jobScores[b]) return summary.jobScores[a] > summary.jobScores[b];
+        return a < b;
+    });
+    cout << "\nTop " << count << " Jobs in the Streamed File by Total Matches\n";
+    cout << "--------------------------------------------\n";
+    for (int i = 0; i < count; ++i) {
+        const int j = order[i];
+        cout << i + 1 << ". " << jobCols.node(j)->id
+             << " | Matches: " << summary.jobMatches[j]
+             << " | Total Score: " << summary.jobScores[j]
+             << " | Avg Score: " << streamedAverage(summary, j) << "\n";
+    }
+    cout << "--------------------------------------------\n";
+}
+
+#endif
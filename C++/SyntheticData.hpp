@@ -0,0 +1,145 @@
+#ifndef SYNTHETIC_DATA_HPP
+#define SYNTHETIC_DATA_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <random>
+using namespace std;
+
+// Generates job and resume CSVs shaped like job_description.csv and
+// resume.csv: a one-column header and one quoted description per line,
+// "<Title> needed with experience in A, B, C. <filler>" for jobs and
+// "Experienced professional skilled in A, noise, B. <filler>" for resumes.
+// Output depends only on the options, so a seed reproduces a corpus exactly.
+
+struct SyntheticCorpusOptions {
+    int records = 1000;
+    int minSkills = 4;       // skills listed per description
+    int maxSkills = 8;
+    int noiseWords = 2;      // non-skill words mixed into a resume's skill list
+    int fillerSentences = 3;
+    unsigned seed = 42;
+};
+
+// A job family and the skills its postings usually ask for
+struct SyntheticProfile {
+    const char* title;
+    vector<const char*> skills;
+};
+
+class SyntheticCorpusGenerator {
+private:
+    // Percent of a record's skills drawn from its profile; the rest come from any profile
+    static const int PROFILE_SKILL_PERCENT = 80;
+
+    SyntheticCorpusOptions options;
+    mt19937 rng;
+    vector<SyntheticProfile> profiles;
+    vector<const char*> allSkills;
+    vector<const char*> fillerWords;
+
+    int uniform(int low, int high) { return uniform_int_distribution<int>(low, high)(rng); }
+
+    template <typename T>
+    const T& pick(const vector<T>& items) { return items[uniform(0, (int)items.size() - 1)]; }
+
+    // Distinct skills for one record, mostly from its profile
+    vector<const char*> pickSkills(const SyntheticProfile& profile) {
+        int count = uniform(options.minSkills, options.maxSkills);
+        if (count > (int)allSkills.size()) count = (int)allSkills.size();
+        vector<const char*> chosen;
+        while ((int)chosen.size() < count) {
+            const bool fromProfile = uniform(1, 100) <= PROFILE_SKILL_PERCENT;
+            const char* skill = fromProfile ? pick(profile.skills) : pick(allSkills);
+            bool seen = false;
+            for (const char* s : chosen) seen = seen || s == skill;
+            if (!seen) chosen.push_back(skill);
+        }
+        return chosen;
+    }
+
+    void appendFiller(string& line) {
+        for (int s = 0; s < options.fillerSentences; ++s) {
+            int words = uniform(4, 9);
+            for (int w = 0; w < words; ++w) {
+                string word = pick(fillerWords);
+                if (w == 0) word[0] = (char)(word[0] - 'a' + 'A');
+                line += ' ';
+                line += word;
+            }
+            line += '.';
+        }
+    }
+
+    bool writeFile(const string& path, const char* header, bool resumes) {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) return false;
+        vector<char> buffer(1 << 20);
+        setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+        rng.seed(options.seed + (resumes ? 1 : 0));
+        fprintf(file, "%s\n", header);
+        string line;
+        for (int i = 0; i < options.records; ++i) {
+            const SyntheticProfile& profile = pick(profiles);
+            vector<const char*> skills = pickSkills(profile);
+
+            line = "\"";
+            if (resumes) {
+                line += "Experienced professional skilled in ";
+                // Noise words sit between skills, as in the sample resumes
+                for (int n = 0; n < options.noiseWords; ++n)
+                    skills.insert(skills.begin() + uniform(1, (int)skills.size()), pick(fillerWords));
+            } else {
+                line += profile.title;
+                line += " needed with experience in ";
+            }
+            for (size_t s = 0; s < skills.size(); ++s) {
+                if (s > 0) line += ", ";
+                line += skills[s];
+            }
+            line += '.';
+            appendFiller(line);
+            line += "\"\n";
+            fwrite(line.data(), 1, line.size(), file);
+        }
+
+        bool ok = ferror(file) == 0;
+        ok = (fclose(file) == 0) && ok;
+        return ok;
+    }
+
+public:
+    explicit SyntheticCorpusGenerator(const SyntheticCorpusOptions& opts) : options(opts) {
+        if (options.minSkills < 1) options.minSkills = 1;
+        if (options.maxSkills < options.minSkills) options.maxSkills = options.minSkills;
+        if (options.noiseWords < 0) options.noiseWords = 0;
+
+        profiles = {
+            {"Data Analyst", {"SQL", "Excel", "Power BI", "Tableau", "Reporting", "Data Cleaning", "Statistics", "Python"}},
+            {"Data Scientist", {"Python", "Pandas", "Statistics", "Machine Learning", "Deep Learning", "NLP", "SQL", "TensorFlow"}},
+            {"Software Engineer", {"Java", "Spring Boot", "REST APIs", "Docker", "Git", "System Design", "Agile", "C++"}},
+            {"ML Engineer", {"Python", "TensorFlow", "Keras", "MLOps", "Computer Vision", "Deep Learning", "Docker", "Machine Learning"}},
+            {"Web Developer", {"JavaScript", "REST APIs", "Git", "Agile", "SQL", "Docker", "System Design", "Java"}}
+        };
+        for (const SyntheticProfile& profile : profiles) {
+            for (const char* skill : profile.skills) {
+                bool seen = false;
+                for (const char* s : allSkills) seen = seen || string(s) == skill;
+                if (!seen) allSkills.push_back(skill);
+            }
+        }
+        fillerWords = {
+            "well", "try", "whom", "character", "truth", "store", "better", "drop", "agent", "give",
+            "quickly", "system", "onto", "cold", "staff", "lawyer", "senior", "scene", "prepare", "soon",
+            "remember", "general", "word", "worry", "week", "half", "thought", "push", "campaign", "read",
+            "national", "address", "almost", "seat", "rather", "woman", "perform", "life", "place", "choice"
+        };
+    }
+
+    bool writeJobs(const string& path) { return writeFile(path, "job_description", false); }
+    bool writeResumes(const string& path) { return writeFile(path, "resume", true); }
+};
+
+#endif
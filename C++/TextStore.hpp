@@ -0,0 +1,203 @@
+#ifndef TEXT_STORE_HPP
+#define TEXT_STORE_HPP
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+using namespace std;
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A whole file mapped copy-on-write: the bytes can be edited in place (the
+// CSV parser unescapes quotes) without touching the file on disk.
+// Falls back to reading the file into memory when it cannot be mapped.
+class MappedFile {
+private:
+    char* bytes;
+    size_t length;
+    bool mapped;
+    vector<char> buffer;   // fallback storage
+
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    bool readWhole(const string& path) {
+        FILE* in = fopen(path.c_str(), "rb");
+        if (in == nullptr) return false;
+        buffer.clear();
+        char chunk[1 << 16];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) buffer.insert(buffer.end(), chunk, chunk + got);
+        fclose(in);
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+    }
+
+    void release() {
+        if (mapped) {
+#ifdef _WIN32
+            UnmapViewOfFile(bytes);
+            CloseHandle(mapping);
+            CloseHandle(file);
+#else
+            munmap(bytes, length);
+#endif
+        }
+        bytes = nullptr;
+        length = 0;
+        mapped = false;
+        buffer.clear();
+    }
+
+public:
+    MappedFile() : bytes(nullptr), length(0), mapped(false) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#endif
+    }
+
+    ~MappedFile() { release(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& path) {
+        release();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+            if (view != nullptr) {
+                bytes = static_cast<char*>(view);
+                length = (size_t)fileSize.QuadPart;
+                mapped = true;
+                return true;
+            }
+            if (mapping) CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                close(fd);
+#ifdef MADV_SEQUENTIAL
+                madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+#endif
+                bytes = static_cast<char*>(view);
+                length = (size_t)info.st_size;
+                mapped = true;
+                return true;
+            }
+        }
+        close(fd);
+#endif
+        return readWhole(path);
+    }
+
+    // Reads the file into memory without mapping it, so it can be replaced
+    // or deleted while the bytes are in use
+    bool read(const string& path) {
+        release();
+        return readWhole(path);
+    }
+
+    char* data() const { return bytes; }
+    size_t size() const { return length; }
+    bool isMapped() const { return mapped; }
+
+    bool contains(const char* p) const { return p >= bytes && p < bytes + length; }
+};
+
+// Owns the text every node description points into: whole input files mapped
+// by the loaders, plus large blocks for descriptions added one at a time.
+// Nothing is ever moved, so the string_views handed out stay valid for the
+// arena's lifetime.
+class TextArena {
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    vector<shared_ptr<MappedFile>> files;
+    vector<unique_ptr<char[]>> blocks;
+    size_t fileBytes;     // size of the files this arena reports
+    size_t blockUsed;
+    size_t blockBytes;    // total size of all blocks
+    size_t currentSize;   // size of the last block
+
+public:
+    TextArena() : fileBytes(0), blockUsed(0), blockBytes(0), currentSize(0) {}
+
+    // Maps a file into the arena; returns nullptr when it cannot be opened
+    MappedFile* mapFile(const string& path) {
+        shared_ptr<MappedFile> file = make_shared<MappedFile>();
+        if (!file->open(path)) return nullptr;
+        addFile(file, true);
+        return file.get();
+    }
+
+    // Keeps an open file alive as long as the arena, for views into it. A file
+    // shared by several arenas is counted only by the one given `counted`.
+    void addFile(const shared_ptr<MappedFile>& file, bool counted) {
+        files.push_back(file);
+        if (counted) fileBytes += file->size();
+    }
+
+    bool owns(const char* p) const {
+        for (const auto& file : files)
+            if (file->contains(p)) return true;
+        return false;
+    }
+
+    // Text already inside a mapped file is returned as is; anything else is
+    // copied into the current block
+    string_view intern(string_view text) {
+        if (text.empty()) return string_view();
+        if (owns(text.data())) return text;
+
+        if (blocks.empty() || currentSize - blockUsed < text.size()) {
+            currentSize = text.size() > BLOCK_SIZE ? text.size() : BLOCK_SIZE;
+            blocks.emplace_back(new char[currentSize]);
+            blockBytes += currentSize;
+            blockUsed = 0;
+        }
+        char* dest = blocks.back().get() + blockUsed;
+        memcpy(dest, text.data(), text.size());
+        blockUsed += text.size();
+        return string_view(dest, text.size());
+    }
+
+    size_t getMemoryUsage() const {
+        return fileBytes + blockBytes;
+    }
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+using namespace std;
+
+// Number of threads to use when the caller asks for 0 ("all cores")
+inline int resolveThreadCount(int requested) {
+    if (requested > 0) return requested;
+    unsigned hw = thread::hardware_concurrency();
+    return hw > 0 ? (int)hw : 1;
+}
+
+// Splits [0, count) into chunks of `grain` items and runs them on `threads`
+// workers. Each worker starts with a contiguous share of the chunks in its own
+// deque and takes work from the front; once it runs dry it steals from the back
+// of another worker's deque, so uneven chunks still keep every core busy.
+// body(begin, end, worker) must only write state owned by items in [begin, end)
+// or by that worker, which keeps results independent of scheduling.
+//
+// The calling thread is worker 0. The other threads start with the first call
+// that needs them and wait between calls until the pool is destroyed, so a
+// pool used for several passes (one per BFS level, say) starts them once.
+// Calls must come from one thread at a time and must not nest.
+class WorkStealingPool {
+private:
+    struct WorkQueue {
+        mutex lock;
+        deque<pair<int, int>> chunks;
+    };
+
+    int threadCount;
+    vector<thread> helpers;              // workers 1..threadCount-1
+    mutex stateLock;                     // guards everything below
+    condition_variable wake;             // helpers wait here for a call
+    condition_variable finished;         // the caller waits here for the helpers
+    const function<void(int)>* task;     // one worker's share of the current call
+    int taskWorkers;                     // workers in the current call, the caller included
+    int running;                         // helpers still working on the current call
+    unsigned long generation;            // calls so far, so each helper joins a call once
+    bool stopping;
+
+    void helperLoop(int self) {
+        unsigned long seen = 0;
+        unique_lock<mutex> guard(stateLock);
+        for (;;) {
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (self >= taskWorkers) continue;   // fewer chunks than threads this time
+            const function<void(int)>* run = task;
+            guard.unlock();
+            (*run)(self);
+            guard.lock();
+            if (--running == 0) finished.notify_one();
+        }
+    }
+
+    static bool popOwn(WorkQueue& q, pair<int, int>& chunk) {
+        lock_guard<mutex> guard(q.lock);
+        if (q.chunks.empty()) return false;
+        chunk = q.chunks.front();
+        q.chunks.pop_front();
+        return true;
+    }
+
+    static bool steal(WorkQueue& q, pair<int, int>& chunk) {
+        lock_guard<mutex> guard(q.lock);
+        if (q.chunks.empty()) return false;
+        chunk = q.chunks.back();
+        q.chunks.pop_back();
+        return true;
+    }
+
+public:
+    explicit WorkStealingPool(int threads)
+        : threadCount(resolveThreadCount(threads)), task(nullptr), taskWorkers(0), running(0),
+          generation(0), stopping(false) {}
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> guard(stateLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& t : helpers) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getThreadCount() const { return threadCount; }
+
+    void parallelFor(int count, int grain, const function<void(int, int, int)>& body) {
+        if (count <= 0) return;
+        if (grain < 1) grain = 1;
+
+        int chunkCount = (count + grain - 1) / grain;
+        int workers = threadCount < chunkCount ? threadCount : chunkCount;
+        if (workers <= 1) {
+            body(0, count, 0);
+            return;
+        }
+
+        vector<WorkQueue> queues(workers);
+        for (int w = 0; w < workers; ++w) {
+            int first = (int)((long long)chunkCount * w / workers);
+            int last = (int)((long long)chunkCount * (w + 1) / workers);
+            for (int c = first; c < last; ++c) {
+                int begin = c * grain;
+                int end = (begin + grain < count) ? begin + grain : count;
+                queues[w].chunks.push_back(make_pair(begin, end));
+            }
+        }
+
+        function<void(int)> run = [&](int self) {
+            pair<int, int> chunk;
+            for (;;) {
+                if (popOwn(queues[self], chunk)) {
+                    body(chunk.first, chunk.second, self);
+                    continue;
+                }
+                bool stolen = false;
+                for (int k = 1; k < workers && !stolen; ++k)
+                    stolen = steal(queues[(self + k) % workers], chunk);
+                if (!stolen) return;  // chunks are never re-queued, so empty means done
+                body(chunk.first, chunk.second, self);
+            }
+        };
+
+        if (helpers.empty()) {
+            helpers.reserve(threadCount - 1);
+            for (int w = 1; w < threadCount; ++w) helpers.emplace_back(&WorkStealingPool::helperLoop, this, w);
+        }
+        {
+            lock_guard<mutex> guard(stateLock);
+            task = &run;
+            taskWorkers = workers;
+            running = workers - 1;
+            generation++;
+        }
+        wake.notify_all();
+        run(0);
+        unique_lock<mutex> guard(stateLock);
+        finished.wait(guard, [&] { return running == 0; });
+        task = nullptr;
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef TOP_K_HPP
+#define TOP_K_HPP
+
+#include <vector>
+#include <algorithm>
+#include "SignatureTable.hpp"
+using namespace std;
+
+// Weighted score kept as the fraction matched / jobPossible so comparisons are
+// exact integer cross-multiplications; value() gives the displayed 0-10 score.
+struct WeightedScore {
+    int num;
+    int den;
+
+    WeightedScore() : num(0), den(1) {}
+    WeightedScore(int n, int d) : num(n), den(d) {}
+
+    double value() const { return (double(num) / double(den)) * 10.0; }
+
+    bool operator<(const WeightedScore& o) const { return (long long)num * o.den < (long long)o.num * den; }
+    bool operator==(const WeightedScore& o) const { return (long long)num * o.den == (long long)o.num * den; }
+};
+
+inline double scoreValue(int score) { return score; }
+inline double scoreValue(double score) { return score; }
+inline double scoreValue(const WeightedScore& score) { return score.value(); }
+
+// Bounded min-heap holding the K best (score, index) pairs. Higher scores rank
+// first and equal scores rank by lower index, matching the first-job-wins rule,
+// so the top entry of a K = 1 heap is exactly the best job of a full scan.
+template <typename Score>
+class TopKHeap {
+public:
+    struct Entry {
+        Score score;
+        int index;
+    };
+
+private:
+    vector<Entry> heap;
+    int capacity;
+
+    // a ranks above b
+    static bool better(const Entry& a, const Entry& b) {
+        if (b.score < a.score) return true;
+        if (a.score < b.score) return false;
+        return a.index < b.index;
+    }
+
+public:
+    TopKHeap() : capacity(1) {}
+
+    void reset(int k) {
+        capacity = k < 1 ? 1 : k;
+        heap.clear();
+        heap.reserve(capacity);
+    }
+
+    int size() const { return (int)heap.size(); }
+    int getCapacity() const { return capacity; }
+    bool full() const { return (int)heap.size() >= capacity; }
+
+    // Lowest-ranked entry kept so far; only valid when not empty
+    const Entry& worst() const { return heap.front(); }
+
+    bool accepts(const Score& score, int index) const {
+        return !full() || better(Entry{score, index}, heap.front());
+    }
+
+    void push(const Score& score, int index) {
+        Entry e{score, index};
+        if (!full()) {
+            heap.push_back(e);
+            push_heap(heap.begin(), heap.end(), better);
+        } else if (better(e, heap.front())) {
+            pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = e;
+            push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+
+    bool contains(int index) const {
+        for (const Entry& e : heap)
+            if (e.index == index) return true;
+        return false;
+    }
+
+    // Pads a short result with the lowest indices not yet present, all scoring `zero`
+    void fillWith(const Score& zero, int count) {
+        for (int i = 0; i < count && !full(); ++i)
+            if (!contains(i)) push(zero, i);
+    }
+
+    // Entries best first; the heap is left sorted and must be reset before reuse
+    const vector<Entry>& sorted() {
+        sort_heap(heap.begin(), heap.end(), better);
+        return heap;
+    }
+};
+
+// Turns the K best signature groups into the K best items. Equal-score groups
+// interleave by index, so up to K members of every kept group compete; the K
+// groups with the lowest representatives always contain the K lowest items.
+template <typename Score>
+inline int expandTopGroups(const vector<typename TopKHeap<Score>::Entry>& groups,
+                           const SignatureGroups& table, int k,
+                           int* outItems, double* outScores) {
+    vector<typename TopKHeap<Score>::Entry> candidates;
+    for (const auto& g : groups) {
+        int first = table.memberOffsets[g.index];
+        int last = table.memberOffsets[g.index + 1];
+        if (last - first > k) last = first + k;
+        for (int m = first; m < last; ++m)
+            candidates.push_back({g.score, table.members[m]});
+    }
+    TopKHeap<Score> best;
+    best.reset(k);
+    for (const auto& c : candidates) best.push(c.score, c.index);
+
+    const auto& ranked = best.sorted();
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        outItems[i] = ranked[i].index;
+        outScores[i] = scoreValue(ranked[i].score);
+    }
+    return (int)ranked.size();
+}
+
+#endif
@@ -1,29 +1,65 @@
+// Count heap allocations in the run metrics; see Metrics.hpp
+#define METRICS_ALLOCATION_HOOKS
+
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cstring>
-#include <ctime>
 #include <algorithm>
+#include <limits>
 #include "LinkedListNodes.hpp"
 #include "MatchingAlgorithm.hpp"
+#include "SkillTaxonomy.hpp"
+#include "Snapshot.hpp"
+#include "StreamingMatch.hpp"
+#include "Metrics.hpp"
+#include "BatchMode.hpp"
+#include "SkillGraph.hpp"
 
 using namespace std;
 
-int main() {
+int main(int argc, char** argv) {
+    // Any argument selects the non-interactive batch mode
+    if (argc > 1) return runBatch(argc, argv);
+
     cout << "============================================" << endl;
     cout << "    JOB MATCHING SYSTEM" << endl;
     cout << "============================================\n" << endl;
     
+    const string jobFile = "job_description.csv";
+    const string resumeFile = "resume.csv";
+    const string snapshotFile = "matching.snapshot";
+    const string taxonomyFile = "skill_taxonomy.txt";
+
+    // A taxonomy file next to the CSVs replaces the built-in skill list; it
+    // has to be in place before anything is matched
+    if (ifstream(taxonomyFile).good()) {
+        string error;
+        if (!loadTaxonomyFile(taxonomyFile, error)) {
+            cout << "Error: " << error << endl;
+            return 1;
+        }
+        cout << "Loaded skill taxonomy from " << taxonomyFile << endl;
+    }
+
     JobLinkedList jobs;
     ResumeLinkedList resumes;
     
-    // Load data
-    if (!loadJobsFromCSV("job_description.csv", jobs)) {
-        return 1;
-    }
-    
-    if (!loadResumesFromCSV("resume.csv", resumes)) {
-        return 1;
+    // Load data, from the snapshot of the last run when the CSVs are unchanged
+    SnapshotResults restored = SNAPSHOT_NO_RESULTS;
+    if (loadSnapshot(snapshotFile, jobFile, resumeFile, jobs, resumes, restored)) {
+        cout << "\nLoaded preprocessed data from " << snapshotFile;
+        if (restored == SNAPSHOT_KEYWORD_RESULTS) cout << " (with last Keyword Matching results)";
+        if (restored == SNAPSHOT_WEIGHTED_RESULTS) cout << " (with last Weighted Matching results)";
+        cout << endl;
+    } else {
+        if (!loadJobsFromCSV(jobFile, jobs)) {
+            return 1;
+        }
+        
+        if (!loadResumesFromCSV(resumeFile, resumes)) {
+            return 1;
+        }
     }
     
     cout << "\nTotal Jobs: " << jobs.getSize() << endl;
@@ -31,6 +67,10 @@ int main() {
     
     KeywordAlgorithm keywordAlg;
     WeightedAlgorithm weightedAlg;
+    SnapshotResults lastRun = restored;   // which algorithm the current results come from
+    bool liveEdits = false;               // lists differ from the CSVs, so no snapshot is saved
+    SkillGraph graph;
+    bool graphCurrent = false;            // built since the lists last changed
     
     int choice;
     do {
@@ -41,29 +81,53 @@ int main() {
         cout << "4. Search Job By ID\n";
         cout << "5. Search Resume By ID\n";
         cout<< "6. Print Memory Usage\n";
-
-
         cout << "7. Exit\n";
+        // Options added later are numbered after Exit, so its number never changes
+        cout << "8. Set Matching Thread Count (current: " << keywordAlg.getThreadCount() << ")\n";
+        cout << "9. Set Recommendations Per Resume (current: " << keywordAlg.getTopK() << ")\n";
+        cout << "10. Stream-Match a Resume File\n";
+        cout << "11. Add Job or Resume\n";
+        cout << "12. Run Metrics (" << (MetricsRegistry::instance().isEnabled() ? "on" : "off") << ")\n";
+        cout << "13. Skill Graph Queries\n";
         cout << "Enter your choice: ";
         cin >> choice;
         
         switch (choice) {
             case 1:
                 keywordAlg.performMatching(resumes, jobs);
+                lastRun = SNAPSHOT_KEYWORD_RESULTS;
+                if (!liveEdits) saveSnapshot(snapshotFile, jobFile, resumeFile, jobs, resumes, lastRun);
                 break;
             case 2:
                 weightedAlg.performWeightedMatching(resumes, jobs);
+                lastRun = SNAPSHOT_WEIGHTED_RESULTS;
+                if (!liveEdits) saveSnapshot(snapshotFile, jobFile, resumeFile, jobs, resumes, lastRun);
                 break;
             case 3:
                 cout << "Please select sorting criteria:\n";
                 cout << "1. By Average Match Score\n";
                 cout << "2. By Total Matches\n";
+                cout << "3. Browse Ranking Page\n";
                 int sortChoice;
                 cin >> sortChoice;
                 if (sortChoice == 1) {
                     jobs.displayTop10ByScore();
                 } else if (sortChoice == 2) {
                     jobs.displayTop10ByMatches();
+                } else if (sortChoice == 3) {
+                    int criterion, firstRank, lastRank;
+                    cout << "Rank by (1 = Average Match Score, 2 = Total Matches): ";
+                    cin >> criterion;
+                    cout << "From rank: ";
+                    cin >> firstRank;
+                    cout << "To rank: ";
+                    cin >> lastRank;
+                    if ((criterion == 1 || criterion == 2) && firstRank >= 1 && lastRank >= firstRank) {
+                        jobs.displayRankingPage(criterion == 1 ? RANK_BY_AVERAGE_SCORE : RANK_BY_TOTAL_MATCHES,
+                                                firstRank - 1, lastRank - firstRank + 1);
+                    } else {
+                        cout << "Invalid page request." << endl;
+                    }
                 } else {
                     cout << "Invalid sorting choice." << endl;
                 }
@@ -72,13 +136,16 @@ int main() {
                 string jobId;
                 cout << "Enter Job ID to search: ";
                 cin >> jobId;
-                jobs.searchById(jobId);
                 JobNode* job = jobs.searchById(jobId);
                 if (job) {
                     cout << "\n*** JOB FOUND ***" << endl;
                     cout << "Job ID: " << job->id << endl;
                     cout << "  Total Matches: " << job->totalMatches << endl;
                     cout << "  Average Match Score: " << job->averageScore << endl;
+                    cout << "  Rank by Average Match Score: " << jobs.getJobRank(job, RANK_BY_AVERAGE_SCORE)
+                         << " of " << jobs.getSize() << endl;
+                    cout << "  Rank by Total Matches: " << jobs.getJobRank(job, RANK_BY_TOTAL_MATCHES)
+                         << " of " << jobs.getSize() << endl;
                     cout << "Skill Requirements:\n";
                     cout << job->description << endl;
                 } else {
@@ -95,8 +162,20 @@ int main() {
                     cout << "\n*** RESUME FOUND ***" << endl;
                     cout << "Resume ID: " << res->id << endl;
                     cout << "\nFull Text:\n" << res->description << endl;
-                    cout << "Best Matched Job ID: " << res->bestJobId << endl;
-                    cout << "Best Matched Job Description: " << res->bestJobDesc << endl;
+                    cout << "Best Matched Job ID: " << res->getBestJobId() << endl;
+                    cout << "Best Matched Job Description: " << res->getBestJobDescription() << endl;
+
+                    const ResumeColumns& cols = resumes.getColumns();
+                    if (cols.topK > 1 && cols.topJob(res->columnIndex, 1) >= 0) {
+                        const JobColumns& jobCols = jobs.getColumns();
+                        cout << "\nTop " << cols.topK << " Recommended Jobs:\n";
+                        for (int rank = 0; rank < cols.topK; ++rank) {
+                            int job = cols.topJob(res->columnIndex, rank);
+                            if (job < 0) break;
+                            cout << "  " << rank + 1 << ". " << jobCols.node(job)->id
+                                 << " | Score: " << cols.topScore(res->columnIndex, rank) << "\n";
+                        }
+                    }
                 } else {
                     cout << "\n*** RESUME NOT FOUND ***" << endl;
                 }
@@ -110,6 +189,10 @@ int main() {
                 cout << "\n--- Memory Usage Report ---\n";
                 cout << "Jobs Linked List Memory: " << jobMemory/1024.0 << " Kbytes\n";
                 cout << "Resumes Linked List Memory: " << resumeMemory/1024.0 << " Kbytes\n";
+                if (graphCurrent) {
+                    cout << "Skill Graph Memory: " << graph.getMemoryUsage()/1024.0 << " Kbytes\n";
+                    totalMemory += graph.getMemoryUsage();
+                }
                 cout << "Total Memory Usage: " << totalMemory/1024.0 << " Kbytes\n";
                 cout << "----------------------------\n";
                 break;
@@ -117,6 +200,237 @@ int main() {
             case 7:
                 cout << "Exiting program. Goodbye!" << endl;
                 break;
+            case 8: {
+                int threads;
+                cout << "Enter number of threads (0 = all cores): ";
+                cin >> threads;
+                if (threads < 0) {
+                    cout << "Invalid thread count." << endl;
+                    break;
+                }
+                keywordAlg.setThreadCount(threads);
+                weightedAlg.setThreadCount(threads);
+                cout << "Matching will use " << resolveThreadCount(threads) << " thread(s)." << endl;
+                break;
+            }
+            case 9: {
+                int k;
+                cout << "Enter number of recommendations per resume: ";
+                cin >> k;
+                if (k < 1) {
+                    cout << "Invalid number of recommendations." << endl;
+                    break;
+                }
+                keywordAlg.setTopK(k);
+                weightedAlg.setTopK(k);
+                cout << "Next matching run keeps the top " << k << " job(s) per resume." << endl;
+                break;
+            }
+            case 10: {
+                string inputFile, outputFile;
+                int algorithm, batchSize;
+                cout << "Enter resume CSV to stream: ";
+                cin >> inputFile;
+                cout << "Enter output CSV for the matches: ";
+                cin >> outputFile;
+                cout << "Algorithm (1 = Keyword, 2 = Weighted): ";
+                cin >> algorithm;
+                cout << "Resumes per batch: ";
+                cin >> batchSize;
+                if ((algorithm != 1 && algorithm != 2) || batchSize < 1) {
+                    cout << "Invalid streaming options." << endl;
+                    break;
+                }
+                ofstream out(outputFile);
+                if (!out.is_open()) {
+                    cerr << "Error: Could not create " << outputFile << endl;
+                    break;
+                }
+                StreamSummary summary;
+                bool ok = (algorithm == 1)
+                    ? streamMatchResumes(inputFile, jobs, keywordAlg, out, batchSize, summary)
+                    : streamMatchResumes(inputFile, jobs, weightedAlg, out, batchSize, summary);
+                if (ok) {
+                    cout << "Streamed " << summary.resumes << " resumes in " << summary.batches
+                         << " batch(es), skipped " << summary.skipped << ", in " << summary.seconds << " seconds.\n";
+                    // Totals for the streamed file only; the loaded lists keep their results
+                    displayStreamTopJobs(jobs.getColumns(), summary, 10);
+                }
+                break;
+            }
+            case 11: {
+                int addChoice;
+                cout << "1. Add Job at End\n";
+                cout << "2. Add Job at Front\n";
+                cout << "3. Add Resume\n";
+                cin >> addChoice;
+                if (addChoice < 1 || addChoice > 3) {
+                    cout << "Invalid choice." << endl;
+                    break;
+                }
+                string description;
+                cout << "Enter description: ";
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                getline(cin, description);
+                if (extract_skills(trim(description)).empty()) {
+                    cout << "No skills found in description (expected \"... in skill, skill.\")." << endl;
+                    break;
+                }
+                liveEdits = true;
+                graphCurrent = false;
+
+                if (addChoice == 3) {
+                    int number = resumes.getSize() + 1;
+                    while (resumes.searchById(makeRecordId('R', number)) != nullptr) number++;
+                    ResumeNode* res = resumes.addResume(makeRecordId('R', number), trim(description));
+                    cout << "Added resume " << res->id << "." << endl;
+                    // Scores only the new resume against the current jobs
+                    if (lastRun == SNAPSHOT_KEYWORD_RESULTS) keywordAlg.matchNewResumes(resumes, jobs);
+                    if (lastRun == SNAPSHOT_WEIGHTED_RESULTS) weightedAlg.matchNewResumes(resumes, jobs);
+                    if (lastRun != SNAPSHOT_NO_RESULTS)
+                        cout << "Best Matched Job ID: " << res->getBestJobId()
+                             << " | Score: " << res->bestMatchScore << endl;
+                } else {
+                    int number = jobs.getSize() + 1;
+                    while (jobs.searchById(makeRecordId('J', number)) != nullptr) number++;
+                    JobNode* job = (addChoice == 1) ? jobs.addJobAtEnd(makeRecordId('J', number), trim(description))
+                                                    : jobs.addJobAtFront(makeRecordId('J', number), trim(description));
+                    cout << "Added job " << job->id << "." << endl;
+                    // Compares only the new job with every resume's current best match
+                    if (lastRun == SNAPSHOT_KEYWORD_RESULTS) keywordAlg.matchNewJobs(resumes, jobs);
+                    if (lastRun == SNAPSHOT_WEIGHTED_RESULTS) weightedAlg.matchNewJobs(resumes, jobs);
+                    if (lastRun != SNAPSHOT_NO_RESULTS)
+                        cout << "Resumes now matched to " << job->id << ": " << job->totalMatches << endl;
+                }
+                break;
+            }
+            case 12: {
+                MetricsRegistry& metrics = MetricsRegistry::instance();
+                int metricsChoice;
+                cout << "1. " << (metrics.isEnabled() ? "Disable" : "Enable") << " Recording\n";
+                cout << "2. Display Metrics\n";
+                cout << "3. Export as JSON\n";
+                cout << "4. Export as CSV\n";
+                cout << "5. Reset Metrics\n";
+                cin >> metricsChoice;
+                if (metricsChoice == 1) {
+                    metrics.setEnabled(!metrics.isEnabled());
+                    cout << "Metrics recording " << (metrics.isEnabled() ? "enabled." : "disabled.") << endl;
+                } else if (metricsChoice == 2) {
+                    metrics.display(cout);
+                } else if (metricsChoice == 3 || metricsChoice == 4) {
+                    string outputFile;
+                    cout << "Enter output file: ";
+                    cin >> outputFile;
+                    ofstream out(outputFile);
+                    if (!out.is_open()) {
+                        cerr << "Error: Could not create " << outputFile << endl;
+                        break;
+                    }
+                    if (metricsChoice == 3) metrics.exportJson(out);
+                    else metrics.exportCsv(out);
+                    cout << "Metrics written to " << outputFile << "." << endl;
+                } else if (metricsChoice == 5) {
+                    metrics.reset();
+                    cout << "Metrics cleared." << endl;
+                } else {
+                    cout << "Invalid choice." << endl;
+                }
+                break;
+            }
+            case 13: {
+                int graphChoice;
+                cout << "1. Jobs Sharing the Most Skills with a Job\n";
+                cout << "2. Resumes Reachable from a Job's Skills\n";
+                cout << "3. Hop Distances from a Job\n";
+                cin >> graphChoice;
+                if (graphChoice < 1 || graphChoice > 3) {
+                    cout << "Invalid choice." << endl;
+                    break;
+                }
+                string jobId;
+                cout << "Enter Job ID: ";
+                cin >> jobId;
+                JobNode* job = jobs.searchById(jobId);
+                if (job == nullptr) {
+                    cout << "  Job not found." << endl;
+                    break;
+                }
+
+                const CompiledTaxonomy& taxonomy = activeTaxonomy();
+                if (!graphCurrent) {
+                    preprocessJobSkills(jobs);
+                    preprocessResumeSkills(resumes);
+                    graph.build(jobs.getColumns(), resumes.getColumns(), taxonomy.getKeywordCount());
+                    graphCurrent = true;
+                }
+                const JobColumns& jobCols = jobs.getColumns();
+                const ResumeColumns& resumeCols = resumes.getColumns();
+                const int source = job->columnIndex;
+
+                cout << "\nSkills of " << job->id << ": ";
+                vector<int> skills = graph.jobSkills(source);
+                for (size_t i = 0; i < skills.size(); ++i) cout << (i > 0 ? ", " : "") << taxonomy.keywordName(skills[i]);
+                cout << endl;
+
+                if (graphChoice == 1 || graphChoice == 2) {
+                    int limit;
+                    cout << "Number of results: ";
+                    cin >> limit;
+                    if (!cin || limit < 1) {
+                        cout << "Invalid number of results." << endl;
+                        cin.clear();
+                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                        break;
+                    }
+                    // There are never more hits than items, so a huge count reserves nothing extra
+                    limit = min(limit, (graphChoice == 1) ? graph.getJobCount() : graph.getResumeCount());
+                    vector<GraphHit> hits;
+                    if (graphChoice == 1) {
+                        hits = graph.similarJobs(source, limit);
+                        cout << "\nJobs Sharing Skills with " << job->id << "\n";
+                    } else {
+                        int reachable;
+                        hits = graph.resumesForJob(source, limit, reachable);
+                        cout << "\n" << reachable << " Resumes Share Skills with " << job->id << "\n";
+                    }
+                    cout << "--------------------------------------------\n";
+                    for (size_t i = 0; i < hits.size(); ++i) {
+                        const string& id = (graphChoice == 1) ? jobCols.node(hits[i].index)->id
+                                                              : resumeCols.node(hits[i].index)->id;
+                        cout << i + 1 << ". " << id << " | Shared Skills: " << hits[i].shared << "\n";
+                    }
+                    cout << "--------------------------------------------\n";
+                } else {
+                    // Jobs and resumes sit an even number of hops away, skills an odd number
+                    vector<int> hops = graph.parallelBfs(graph.jobVertex(source), keywordAlg.getThreadCount());
+                    vector<int> jobsAt, resumesAt;
+                    int unreachableJobs = 0, unreachableResumes = 0;
+                    for (int j = 0; j < graph.getJobCount(); ++j) {
+                        int h = hops[graph.jobVertex(j)];
+                        if (h < 0) { unreachableJobs++; continue; }
+                        if ((int)jobsAt.size() <= h / 2) jobsAt.resize(h / 2 + 1, 0);
+                        jobsAt[h / 2]++;
+                    }
+                    for (int r = 0; r < graph.getResumeCount(); ++r) {
+                        int h = hops[graph.resumeVertex(r)];
+                        if (h < 0) { unreachableResumes++; continue; }
+                        if ((int)resumesAt.size() <= h / 2) resumesAt.resize(h / 2 + 1, 0);
+                        resumesAt[h / 2]++;
+                    }
+                    cout << "\nHop Distances from " << job->id << "\n";
+                    cout << "--------------------------------------------\n";
+                    const size_t levels = max(jobsAt.size(), resumesAt.size());
+                    for (size_t level = 1; level < levels; ++level) {
+                        cout << "Hops " << level * 2 << ": "
+                             << (level < jobsAt.size() ? jobsAt[level] : 0) << " jobs, "
+                             << (level < resumesAt.size() ? resumesAt[level] : 0) << " resumes\n";
+                    }
+                    cout << "Unreachable: " << unreachableJobs << " jobs, " << unreachableResumes << " resumes\n";
+                    cout << "--------------------------------------------\n";
+                }
+                break;
+            }
             default:
                 cout << "Invalid choice. Please try again." << endl;
         }